@@ -7,25 +7,39 @@
 #include "s_stack.h"
 #include "player.h"
 #include "debug.h"
+#include "input_log.h"
+#include "render_thread.h"
+#include "conf.h"
 
 #include <SFML/System/Time.hpp>
 #include <SFML/Graphics/RenderWindow.hpp>
 
+#include <memory>
+#include <string>
+
 class Application {
 public:
-    Application();
+    explicit Application(sf::Time time_per_tick = conf::TIME_PER_FRAME);
+    Application(sf::Time time_per_tick, const std::string& record_filename);
 
     void run();
 private:
     void process_input();
     void update(sf::Time delta_time);
-    void render();
+    void render(float interpolation);
     void register_states();
 
+    /// Fixed simulation step, independent of the frame rate.
+    sf::Time m_time_per_tick;
     sf::RenderWindow m_window;
     TextureHolder m_textures;
     FontHolder m_fonts;
     Player m_player;
     StateStack m_state_stack;
     Debug m_debug;
+    /// Records the player's input if a record file was given.
+    std::unique_ptr<InputRecorder> m_recorder;
+    /// Draws the frames recorded by render(), declared after m_window to be
+    /// stopped before the window is destroyed.
+    RenderThread m_render_thread;
 };
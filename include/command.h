@@ -1,29 +1,54 @@
 #pragma once
 
 #include "category.h"
+#include "entity_handle.h"
+#include "inplace_function.h"
+#include "node_type.h"
 
 #include <SFML/System/Time.hpp>
 
-#include <functional>
-#include <cassert>
 
 class SceneNode;
 
+/**
+ * @struct Command
+ * Action to be forwarded through the scene graph to nodes of a category, or
+ * delivered directly to one entity if target is a valid handle.
+ * @note Command is move-only, its action is stored inline (no heap) and holds
+ * at most COMMAND_CAPACITY bytes of captures. Use clone() to push a copy of a
+ * stored command, e.g. a key binding.
+ */
 struct Command {
+    /// Inline storage of action: enough for a this pointer and a reference,
+    /// or a member function pointer bound by derived_action().
+    static constexpr std::size_t COMMAND_CAPACITY = 4 * sizeof(void*);
+    using Action = InplaceFunction<void(SceneNode& node, sf::Time dt),
+          COMMAND_CAPACITY>;
+
     Command();
+    Command(Command&&) noexcept = default;
+    Command& operator=(Command&&) noexcept = default;
+    Command clone() const;
+
     // treat function as object
-    std::function<void(SceneNode& node, sf::Time dt)> action;
+    Action action;
     // store the recipients of the command in a category
     unsigned int category;
+    // or address the command to one entity, category is then ignored
+    EntityHandle target;
 };
 
+/**
+ * Wraps fn to downcast the node to GameObject before invoking fn.
+ * @note Returns the lambda itself rather than a std::function, so that it is
+ * stored inline in Command::action.
+ * @see node_cast(), the downcast is checked by type tag, not RTTI.
+ */
 template <typename GameObject, typename Function>
-std::function<void(SceneNode&, sf::Time)> derived_action(Function fn)
+auto derived_action(Function fn)
 {
-    return [=] (SceneNode& node, sf::Time dt) {
-        // check if cast is safe
-        assert(dynamic_cast<GameObject*>(&node) != nullptr);
-        // downcast node and invoke function on it
-        fn(static_cast<GameObject&>(node), dt);
+    return [fn] (SceneNode& node, sf::Time dt) {
+        // downcast node (asserted by type tag) and invoke function on it
+        fn(node_cast<GameObject>(node), dt);
     };
 }
@@ -2,18 +2,36 @@
 
 #include "command.h"
 
-#include <queue>
+#include <cstddef>
+#include <span>
+#include <vector>
 
 /**
  * @class CommandQueue
  * FIFO - to act as a wrapper for commands to be queued.
+ * @note Commands are moved in and out of the queue, never copied. The queue
+ * is a growable ring buffer that keeps its capacity across ticks.
  */
 class CommandQueue {
 public:
-    void push(const Command& command);
+    CommandQueue();
+    void push(Command&& command);
     Command pop();
+    std::span<Command> drain();
     bool is_empty() const;
+    std::size_t size() const;
 private:
-    /// The three public methods forward commands to underlying private std::queue.
-    std::queue<Command> m_queue;
+    void grow();
+    void linearize();
+
+    /// Ring buffer of commands, its size is the capacity (a power of two).
+    std::vector<Command> m_ring;
+    /// Index of the front command in m_ring.
+    std::size_t m_head;
+    /// Number of queued commands.
+    std::size_t m_count;
+    /// Commands handed out by the last drain(), storage swapped with m_ring.
+    std::vector<Command> m_drained;
+    /// Range of m_drained that was handed out, reset on the next drain().
+    std::span<Command> m_drained_span;
 };
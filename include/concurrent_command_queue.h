@@ -0,0 +1,64 @@
+#pragma once
+
+#include "command.h"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <ostream>
+
+class CommandQueue;
+
+/**
+ * @class ConcurrentCommandQueue
+ * Bounded lock-free MPSC queue of commands. Any thread (input sampling, AI
+ * workers, asset loaders...) can push without a mutex; only the simulation
+ * thread drains it, into the World's CommandQueue.
+ * @note Each slot carries a sequence number that tells producers and the
+ * consumer whether it is free or filled, so no lock is ever taken. A push into
+ * a full queue fails and is counted, instead of blocking the producer.
+ */
+class ConcurrentCommandQueue {
+public:
+    /**
+     * @struct Stats
+     * Backpressure statistics of the queue.
+     */
+    struct Stats {
+        std::size_t capacity; /**< Number of slots. */
+        std::size_t pushed; /**< Total commands accepted. */
+        std::size_t rejected; /**< Total pushes that failed, queue full. */
+        std::size_t rejected_since_drain; /**< Failed pushes since last drain. */
+        std::size_t peak_drained; /**< Most commands drained at once. */
+    };
+
+    explicit ConcurrentCommandQueue(std::size_t capacity);
+
+    bool try_push(Command&& command);
+    std::size_t drain_into(CommandQueue& commands);
+    Stats get_stats() const;
+private:
+    /**
+     * @struct Slot
+     * One command and its sequence number, on its own cache line so that
+     * producers writing neighbouring slots do not contend.
+     */
+    struct alignas(64) Slot {
+        std::atomic<std::size_t> sequence;
+        Command command;
+    };
+
+    std::unique_ptr<Slot[]> m_slots;
+    const std::size_t m_mask;
+    /// Producers claim slots by advancing m_enqueue_pos.
+    alignas(64) std::atomic<std::size_t> m_enqueue_pos;
+    /// Only touched by the consumer.
+    alignas(64) std::size_t m_dequeue_pos;
+    std::size_t m_peak_drained;
+    std::atomic<std::size_t> m_pushed;
+    std::atomic<std::size_t> m_rejected;
+    std::atomic<std::size_t> m_rejected_since_drain;
+};
+
+bool run_command_stress(std::size_t producer_count, std::size_t command_count,
+        std::ostream& out);
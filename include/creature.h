@@ -13,6 +13,9 @@
 
 class Creature : public Entity {
 public:
+    /// Tag of Creature, see node_cast().
+    static constexpr NodeType::Type NODE_TYPE = NodeType::Creature;
+
     /**
      * @enum Type
      * Type of Creature Entity.
@@ -32,31 +35,39 @@ public:
 
     virtual unsigned int get_category() const;
     virtual sf::FloatRect get_bounding_rect() const;
-    virtual bool is_marked_for_removal() const;
+    virtual void on_destroy(CommandQueue& commands);
+    virtual sf::Time get_death_duration() const;
+    virtual bool is_reclaimable() const;
     bool is_allied() const;
     float get_max_speed() const;
     void attack();
 private:
     virtual void draw_current(sf::RenderTarget& target, sf::RenderStates states)
         const;
+    virtual void collect_current(SpriteBatch& batch,
+            const sf::Transform& transform) const;
+    virtual sf::FloatRect get_cull_bounds() const;
     virtual void update_current(sf::Time delta_time, CommandQueue& commands);
     void update_pathing(sf::Time delta_time);
-    void check_pickup_drop(CommandQueue& commands);
     void check_projectile_launch(sf::Time delta_time, CommandQueue& commands);
-    void create_projectile(SceneNode& node, Projectile::Type type,
-            float x_offset, float y_offset, const TextureHolder& textures) const;
-    void create_pickup(SceneNode& node, const TextureHolder& textures) const;
+    void create_projectile(Projectile::Type type, float x_offset,
+            float y_offset);
     void update_texts();
 
+    /// Attack command shared by all creatures, addressed to the attacking
+    /// creature when pushed.
+    static const Command ATTACK_PROTOTYPE;
+
     Type m_type;
     sf::Sprite m_sprite;
-    Command m_attack_command;
+    /// Textures of projectiles created by the creature.
+    const TextureHolder* m_textures;
     sf::Time m_attack_countdown;
     bool m_is_attacking;
     float m_attack_rate;
-    bool m_is_marked_for_removal;
-    Command m_drop_pickup_command;
     float m_travelled_distance;
     std::size_t m_direction_index;
     TextNode* m_health_display;
+    /// Hitpoints shown by m_health_display.
+    float m_displayed_hitpoints;
 };
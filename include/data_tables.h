@@ -8,13 +8,13 @@
 #pragma once
 
 #include "entity.h"
+#include "effect.h"
 #include "r_ids.h"
 
 #include <SFML/System/Time.hpp>
 #include <SFML/Graphics/Color.hpp>
 
 #include <vector>
-#include <functional>
 
 // forward definition to use creature class
 class Creature;
@@ -38,6 +38,9 @@ struct CreatureData {
     float speed; /**< float speed for Creature speed. */
     Textures::ID texture; /**< Textures::ID enum to texture. */
     sf::Time attack_interval; /**< Specified attack_interval in sf::Time. */
+    /** Time the Creature stays in the world after destruction, for its death
+     * effect. Default is sf::Time::Zero. */
+    sf::Time death_duration;
     /** std::vector of struct Direction, storing all directions. */
     std::vector<Direction> directions;
 };
@@ -46,11 +49,20 @@ struct ProjectileData {
     float damage;
     float speed;
     Textures::ID texture;
+    /** Distance guided projectiles acquire targets within. */
+    float guide_range;
+    /** Time between target re-evaluations of guided projectiles, zero to
+     * re-evaluate every tick. */
+    sf::Time retarget_interval;
 };
 
+/**
+ * @struct PickupData
+ * Struct to store data of the Pickup, its effect and texture.
+ */
 struct PickupData {
-    std::function<void(Creature&)> action;
-    Textures::ID texture;
+    Effect effect; /**< Effect applied to the Creature that picks it up. */
+    Textures::ID texture; /**< Textures::ID enum to texture. */
 };
 
 std::vector<CreatureData> initialize_creature_data();
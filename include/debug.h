@@ -15,6 +15,4 @@ public:
     void print_window() const;
     void print_video_modes() const;
     void print_text(const sf::Text& text) const;
-
-    bool m_is_drawing_bounding_rect;
 };
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace sf {
+    class Font;
+}
+class DrawList;
+
+/**
+ * @class DebugDraw
+ * Collects debug lines, rects and texts of one frame into a single vertex
+ * batch, drawn with one draw call however many shapes there are.
+ * @note Everything is textured by one font page: texts by their glyphs, lines
+ * by the white square every font page reserves for underlines, so lines and
+ * texts share the batch.
+ * @note Collecting is skipped while disabled, callers check is_enabled()
+ * before computing what they add.
+ * @see World::draw()
+ */
+class DebugDraw : private sf::NonCopyable {
+public:
+    explicit DebugDraw(const sf::Font& font);
+
+    void set_enabled(bool enabled);
+    bool is_enabled() const;
+    void toggle();
+    void set_pixel_size(float pixel_size);
+
+    void clear();
+    void line(sf::Vector2f from, sf::Vector2f to, sf::Color color);
+    void rect(const sf::FloatRect& rect, sf::Color color);
+    void cross(sf::Vector2f center, float size, sf::Color color);
+    void text(sf::Vector2f position, const std::string& text,
+            sf::Color color = sf::Color::White);
+    void draw(DrawList& frame) const;
+    std::size_t get_vertex_count() const;
+private:
+    const sf::Font& m_font;
+    bool m_is_enabled;
+    /// Size of one screen px in units of the view drawn in, lines are one
+    /// px wide and texts CHARACTER_SIZE px high however the view is zoomed.
+    float m_pixel_size;
+    /// Lines and glyphs of the frame, as triangles.
+    std::vector<sf::Vertex> m_vertices;
+};
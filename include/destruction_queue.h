@@ -0,0 +1,43 @@
+#pragma once
+
+#include "scene_node.h"
+
+#include <SFML/System/Time.hpp>
+
+#include <vector>
+
+class Entity;
+class CommandQueue;
+
+/**
+ * @class DestructionQueue
+ * Explicit lifecycle for destroyed entities: destroy -> pending death (optional
+ * death effect duration) -> batched reclamation.
+ * @note Entities push themselves on Entity::destroy() (or the damage that
+ * destroys them), so live entities are never polled for is_destroyed().
+ */
+class DestructionQueue {
+public:
+    void push(Entity& entity);
+    void update(sf::Time delta_time, CommandQueue& commands);
+    std::size_t get_pending_count() const;
+private:
+    /**
+     * @struct PendingDeath
+     * Destroyed entity and the time left on its death effect.
+     */
+    struct PendingDeath {
+        Entity* entity;
+        sf::Time countdown;
+        bool is_started;
+    };
+
+    void reclaim();
+
+    /// Entities in their death effect phase.
+    std::vector<PendingDeath> m_pending;
+    /// Entities whose death effect is over, to be detached together.
+    std::vector<SceneNode*> m_expired;
+    /// Detached nodes, freed together at the end of reclaim().
+    std::vector<SceneNode::Ptr> m_reclaimed;
+};
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <SFML/Graphics/RectangleShape.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/View.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace sf {
+    class Drawable;
+    class RenderTarget;
+    class Text;
+    class Texture;
+}
+
+/**
+ * @class DrawList
+ * Recorded frame: views, textured triangles and copies of sprites and shapes,
+ * in draw order. Recorded by the simulation thread with the state of one tick,
+ * then drawn by the render thread without touching the scene.
+ * @note Texts are recorded as glyph quads textured by their font page, the
+ * render thread never calls into sf::Font (see get_glyph_page()).
+ * @see RenderThread
+ */
+class DrawList {
+public:
+    /**
+     * @typedef std::function<void(sf::RenderTarget&)> Callback
+     * Custom drawing run on the render thread, e.g. GUI rendering.
+     */
+    typedef std::function<void(sf::RenderTarget&)> Callback;
+
+    DrawList();
+
+    void clear();
+    void set_view(const sf::View& view);
+    void add(const sf::Vertex* vertices, std::size_t count,
+            const sf::Texture* texture);
+    void add(const sf::Sprite& sprite,
+            const sf::Transform& transform = sf::Transform::Identity);
+    void add(const sf::Text& text,
+            const sf::Transform& transform = sf::Transform::Identity);
+    void add(const sf::RectangleShape& shape);
+    void add(const sf::Drawable& drawable, const sf::Transform& transform,
+            const sf::Texture* texture);
+    void add(Callback callback);
+    void set_synchronous();
+    bool is_synchronous() const;
+    void set_interpolation(float interpolation);
+    float get_interpolation() const;
+    void set_sequence(std::uint64_t sequence, std::uint64_t drawn_sequence);
+    std::uint64_t get_sequence() const;
+    std::uint64_t get_drawn_sequence() const;
+    void draw(sf::RenderTarget& target) const;
+private:
+    /**
+     * @enum Kind
+     * What an item draws, and which storage index refers to.
+     */
+    enum class Kind {
+        View,
+        Vertices,
+        Sprite,
+        Shape,
+        Drawable,
+        Callback,
+    };
+
+    /**
+     * @struct Item
+     * One draw call, index (and count) refer to the storage of its kind.
+     */
+    struct Item {
+        Kind kind;
+        std::size_t index;
+        std::size_t count;
+        const sf::Texture* texture;
+        const sf::Drawable* drawable;
+        sf::Transform transform;
+    };
+
+    std::vector<Item> m_items;
+    /// Storage by kind, keeps capacity between frames.
+    std::vector<sf::View> m_views;
+    std::vector<sf::Vertex> m_vertices;
+    std::vector<sf::Sprite> m_sprites;
+    std::vector<sf::RectangleShape> m_shapes;
+    std::vector<Callback> m_callbacks;
+    /// Frame must be drawn before the simulation goes on, see
+    /// set_synchronous().
+    bool m_synchronous;
+    /// Fraction of a tick elapsed since the last update when recorded.
+    float m_interpolation;
+    /// Number of this frame, and of the last frame drawn when it was begun.
+    std::uint64_t m_sequence;
+    std::uint64_t m_drawn_sequence;
+};
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+// forward Creature class to use in implementation
+class Creature;
+
+/**
+ * @namespace Effects
+ * A namespace to hold effect kinds in.
+ */
+namespace Effects {
+    /**
+     * @enum Kind
+     * Kind of effect, dispatched on in EffectBuffer::apply().
+     */
+    enum Kind : std::uint8_t {
+        None,
+        Heal,
+        /// @todo AttackRate, Arrows...
+        KindCount,
+    };
+}
+
+/**
+ * @struct Effect
+ * Data-driven effect, an effect kind and its magnitude.
+ * @note Effect is trivially copyable, so that it can be buffered and
+ * serialized as-is.
+ */
+struct Effect {
+    Effects::Kind kind; /**< Effects::Kind enum of the effect. */
+    float magnitude; /**< float magnitude of the effect, e.g. HP healed. */
+};
+
+static_assert(std::is_trivially_copyable_v<Effect>,
+        "Effect must stay trivially copyable to be serialized");
+
+/**
+ * @class EffectBuffer
+ * Buffers all effects applied within a tick, to be resolved in one pass.
+ */
+class EffectBuffer {
+public:
+    void push(Creature& target, Effect effect);
+    void apply();
+    bool is_empty() const;
+private:
+    /**
+     * @struct PendingEffect
+     * Effect and its target, waiting to be applied.
+     */
+    struct PendingEffect {
+        Creature* target;
+        Effect effect;
+    };
+
+    std::vector<PendingEffect> m_pending;
+};
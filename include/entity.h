@@ -4,6 +4,12 @@
 /// Include command_queue.h in entity.h because all derived classes of Entity
 /// use CommandQueue.
 #include "command_queue.h"
+#include "entity_handle.h"
+
+class DestructionQueue;
+class EntityRegistry;
+class SpawnQueue;
+class GameEventBus;
 
 /**
  * @class Entity
@@ -14,8 +20,28 @@
  */
 class Entity : public SceneNode {
 public:
+    /**
+     * @struct Context
+     * World systems shared by all entities. Context keeps one pointer per
+     * entity, instead of every entity holding a pointer to every system.
+     */
+    struct Context {
+        Context() :
+            destructions(nullptr), registry(nullptr), spawns(nullptr),
+            events(nullptr) {}
+        DestructionQueue* destructions;
+        EntityRegistry* registry;
+        SpawnQueue* spawns;
+        GameEventBus* events;
+    };
+
+    /// Tag of Entity, see node_cast().
+    static constexpr NodeType::Type NODE_TYPE = NodeType::Entity;
+
     /// All entities have velocity and hitpoints.
-    explicit Entity(float hitpoints) : m_velocity(), m_hitpoints(hitpoints) {}
+    explicit Entity(float hitpoints, NodeType::Type node_type = NODE_TYPE) :
+        SceneNode(Category::None, node_type),
+        m_velocity(), m_hitpoints(hitpoints), m_context(nullptr), m_handle() {}
     void heal(float hitpoints);
     void damage(float hitpoints);
     void destroy();
@@ -23,6 +49,15 @@ public:
     float get_hitpoints() const;
     bool is_destroyed() const;
 
+    void set_context(Context* context);
+    Context* get_context() const;
+    void spawn(Ptr entity);
+    EntityHandle get_handle() const;
+    void release_handle();
+    virtual void on_destroy(CommandQueue& commands);
+    virtual sf::Time get_death_duration() const;
+    virtual bool is_reclaimable() const;
+
     void set_velocity(sf::Vector2f velocity);
     void set_velocity(float vx, float vy);
     void accelerate(sf::Vector2f velocity);
@@ -33,6 +68,13 @@ protected:
     /// Virtual fn overwritten in derived class(es) implementation.
     virtual void update_current(sf::Time delta_time, CommandQueue& commands);
 private:
+    virtual void debug_draw_current(DebugDraw& debug,
+            const sf::Transform& transform) const;
+    void enqueue_destruction();
+
     float m_hitpoints;
     sf::Vector2f m_velocity;
+    Context* m_context;
+    /// Address of the entity in the registry of its context.
+    EntityHandle m_handle;
 };
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @struct EntityHandle
+ * Stable address of an entity in the EntityRegistry. The generation tells a
+ * handle to a reclaimed entity from a handle to the entity that reuses its
+ * slot, so stale handles are never dereferenced.
+ * @note Default constructed handle is invalid (generation 0).
+ */
+struct EntityHandle {
+    EntityHandle() : index(0), generation(0) {}
+    EntityHandle(std::uint32_t index, std::uint32_t generation) :
+        index(index), generation(generation) {}
+
+    bool is_valid() const { return generation != 0; }
+
+    bool operator==(const EntityHandle& other) const
+    {
+        return index == other.index && generation == other.generation;
+    }
+
+    std::uint32_t index; /**< Slot of the entity in the registry. */
+    std::uint32_t generation; /**< Generation of the slot when registered. */
+};
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "entity_handle.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Entity;
+
+/**
+ * @class EntityRegistry
+ * Maps entity handles to live entities in O(1), so commands can be addressed
+ * to one entity instead of broadcast to a category.
+ * @note Slots of unregistered entities are reused; their generation is bumped
+ * so that old handles resolve to nullptr.
+ */
+class EntityRegistry {
+public:
+    EntityHandle add(Entity& entity);
+    void remove(EntityHandle handle);
+    Entity* get(EntityHandle handle) const;
+    std::size_t size() const;
+private:
+    /**
+     * @struct Slot
+     * Registered entity (nullptr if free) and the generation of the slot.
+     */
+    struct Slot {
+        Entity* entity;
+        std::uint32_t generation;
+    };
+
+    std::vector<Slot> m_slots;
+    /// Indices of free slots, reused last in first out.
+    std::vector<std::uint32_t> m_free;
+};
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "inplace_function.h"
+
+#include <cstddef>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @class EventBus
+ * Typed event bus: producers publish POD events into one buffer per event
+ * type during the tick, and each buffer is delivered to its subscribers in one
+ * batched pass at a sync point, dispatch<Event>().
+ * @note A subscriber is called once per batch with a span of events, not once
+ * per event. Events published while a batch is delivered are delivered on the
+ * next dispatch.
+ */
+template <typename... Events>
+class EventBus {
+public:
+    static_assert((std::is_trivially_copyable_v<Events> && ...),
+            "Events must be trivially copyable (POD)");
+
+    /// Subscribers may capture up to two pointers, e.g. this.
+    template <typename Event>
+    using Subscriber = InplaceFunction<void(std::span<const Event> events),
+          2 * sizeof(void*)>;
+
+    template <typename Event>
+    void publish(const Event& event)
+    {
+        channel<Event>().pending.push_back(event);
+    }
+
+    template <typename Event, typename Function>
+    void subscribe(Function fn)
+    {
+        channel<Event>().subscribers.emplace_back(std::move(fn));
+    }
+
+    /**
+     * Delivers all pending events of type Event to every subscriber, then
+     * clears them. Buffers keep their capacity between ticks.
+     */
+    template <typename Event>
+    void dispatch()
+    {
+        Channel<Event>& events = channel<Event>();
+        if (events.pending.empty())
+            return;
+        // subscribers may publish, deliver from a separate buffer
+        events.delivering.swap(events.pending);
+        std::span<const Event> batch(events.delivering);
+        for (const Subscriber<Event>& subscriber : events.subscribers)
+            subscriber(batch);
+        events.delivering.clear();
+    }
+
+    template <typename Event>
+    std::size_t get_pending_count() const
+    {
+        return std::get<Channel<Event>>(m_channels).pending.size();
+    }
+private:
+    /**
+     * @struct Channel
+     * Pending events of one type and their subscribers.
+     */
+    template <typename Event>
+    struct Channel {
+        std::vector<Event> pending;
+        std::vector<Event> delivering;
+        std::vector<Subscriber<Event>> subscribers;
+    };
+
+    template <typename Event>
+    Channel<Event>& channel()
+    {
+        return std::get<Channel<Event>>(m_channels);
+    }
+
+    std::tuple<Channel<Events>...> m_channels;
+};
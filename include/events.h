@@ -0,0 +1,50 @@
+#pragma once
+
+#include "event_bus.h"
+#include "entity_handle.h"
+#include "effect.h"
+
+#include <SFML/System/Vector2.hpp>
+
+/**
+ * @namespace Events
+ * Gameplay events, published during the tick and delivered in batches by
+ * GameEventBus.
+ */
+namespace Events {
+    /**
+     * @struct Damage
+     * Target takes amount of damage.
+     */
+    struct Damage {
+        EntityHandle target;
+        float amount;
+    };
+
+    /**
+     * @struct PickupCollected
+     * Collector picked up a pickup with effect.
+     */
+    struct PickupCollected {
+        EntityHandle collector;
+        Effect effect;
+    };
+
+    /**
+     * @struct CreatureDied
+     * A creature of category died at position, published by its death effect.
+     */
+    struct CreatureDied {
+        unsigned int category;
+        sf::Vector2f position;
+    };
+}
+
+/**
+ * @class GameEventBus
+ * Event bus of all gameplay events, shared with entities through
+ * Entity::Context.
+ */
+class GameEventBus : public EventBus<Events::Damage, Events::PickupCollected,
+    Events::CreatureDied> {
+};
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "creature.h"
+#include "spawn_grid.h"
+
+#include <SFML/System/Time.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include <random>
+#include <vector>
+
+class OffscreenRenderer;
+
+/**
+ * @struct HordeConfig
+ * Load shape of a horde: which creatures, how they are placed, and how their
+ * count ramps up level by level.
+ * @note Defaults are the "bunny attack" mode - each level doubles the bunnies.
+ */
+struct HordeConfig {
+    /**
+     * @enum Distribution
+     * How spawns are placed around the horde center.
+     */
+    enum Distribution : unsigned int {
+        Uniform, /**< Uniform in the square of size 2 * radius. */
+        Ring, /**< On the circle of radius. */
+        Cluster, /**< Packed around a few points on the circle of radius. */
+    };
+
+    /**
+     * @struct Group
+     * Creature type and its weight in the horde mix.
+     */
+    struct Group {
+        Creature::Type type;
+        float weight;
+    };
+
+    std::vector<Group> groups{{Creature::Bunny, 1.f}};
+    Distribution distribution = Ring;
+    float radius = 400.f; /**< Distance from the center spawns are placed at. */
+    std::size_t initial_count = 16; /**< Creatures spawned on the first level. */
+    float growth = 2.f; /**< Creature count multiplier per level. */
+    std::size_t level_count = 8;
+    sf::Time level_duration = sf::seconds(5.f);
+    float projectile_rate = 0.f; /**< Projectiles fired per second. */
+    unsigned int seed = 0; /**< Seeds the horde's and the game's RNG. */
+};
+
+/**
+ * @class Horde
+ * Ramps a horde level by level, and decides what to spawn each tick. World
+ * creates the spawned entities.
+ * @see World::start_horde().
+ */
+class Horde {
+public:
+    explicit Horde(const HordeConfig& config);
+
+    void update(sf::Time delta_time, sf::Vector2f center,
+            std::vector<SpawnPoint>& creatures,
+            std::vector<sf::Vector2f>& projectiles);
+    bool is_level_over() const;
+    bool is_finished() const;
+    std::size_t get_level() const;
+private:
+    void spawn_wave(sf::Vector2f center, std::vector<SpawnPoint>& creatures);
+    sf::Vector2f random_position(sf::Vector2f center);
+    sf::Vector2f on_ring(sf::Vector2f center);
+
+    HordeConfig m_config;
+    std::default_random_engine m_random_engine;
+    std::discrete_distribution<std::size_t> m_group_distribution;
+    std::vector<sf::Vector2f> m_cluster_centers;
+    std::size_t m_level;
+    sf::Time m_level_time;
+    float m_projectile_budget;
+    bool m_is_wave_spawned;
+    bool m_is_level_over;
+};
+
+HordeConfig parse_horde_config(int argc, char* argv[]);
+void run_horde(const HordeConfig& config,
+        OffscreenRenderer* renderer = nullptr);
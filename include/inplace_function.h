@@ -0,0 +1,149 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template <typename Signature, std::size_t Capacity>
+class InplaceFunction;
+
+/**
+ * @class InplaceFunction
+ * Move-only replacement for std::function that stores its callable inline,
+ * in a fixed buffer of Capacity bytes. It never allocates: callables that do
+ * not fit the buffer fail to compile instead of spilling to the heap.
+ * @note Copying is explicit through clone(), so that commands stored as
+ * prototypes (key bindings, attack commands...) are only copied where intended.
+ */
+template <typename Result, typename... Args, std::size_t Capacity>
+class InplaceFunction<Result(Args...), Capacity> {
+public:
+    InplaceFunction() noexcept : m_ops(nullptr) {}
+
+    template <typename Function, typename = std::enable_if_t<
+        !std::is_same_v<std::decay_t<Function>, InplaceFunction>>>
+    InplaceFunction(Function&& fn) : m_ops(nullptr)
+    {
+        emplace(std::forward<Function>(fn));
+    }
+
+    InplaceFunction(InplaceFunction&& other) noexcept : m_ops(other.m_ops)
+    {
+        if (m_ops != nullptr) {
+            m_ops->move(&m_storage, &other.m_storage);
+            other.m_ops = nullptr;
+        }
+    }
+
+    InplaceFunction& operator=(InplaceFunction&& other) noexcept
+    {
+        if (this != &other) {
+            reset();
+            if (other.m_ops != nullptr) {
+                other.m_ops->move(&m_storage, &other.m_storage);
+                m_ops = other.m_ops;
+                other.m_ops = nullptr;
+            }
+        }
+        return *this;
+    }
+
+    template <typename Function, typename = std::enable_if_t<
+        !std::is_same_v<std::decay_t<Function>, InplaceFunction>>>
+    InplaceFunction& operator=(Function&& fn)
+    {
+        reset();
+        emplace(std::forward<Function>(fn));
+        return *this;
+    }
+
+    InplaceFunction(const InplaceFunction&) = delete;
+    InplaceFunction& operator=(const InplaceFunction&) = delete;
+
+    ~InplaceFunction() { reset(); }
+
+    /** Copy the stored callable into a new InplaceFunction. */
+    InplaceFunction clone() const
+    {
+        InplaceFunction copy;
+        if (m_ops != nullptr) {
+            m_ops->copy(&copy.m_storage, &m_storage);
+            copy.m_ops = m_ops;
+        }
+        return copy;
+    }
+
+    Result operator()(Args... args) const
+    {
+        assert(m_ops != nullptr);
+        return m_ops->invoke(&m_storage, std::forward<Args>(args)...);
+    }
+
+    explicit operator bool() const noexcept { return m_ops != nullptr; }
+
+    void reset() noexcept
+    {
+        if (m_ops != nullptr) {
+            m_ops->destroy(&m_storage);
+            m_ops = nullptr;
+        }
+    }
+
+private:
+    /**
+     * @struct Ops
+     * Type-erased operations on the stored callable, one static table per
+     * callable type.
+     */
+    struct Ops {
+        Result (*invoke)(const void* storage, Args&&... args);
+        void (*copy)(void* dst, const void* src);
+        void (*move)(void* dst, void* src);
+        void (*destroy)(void* storage);
+    };
+
+    template <typename Function>
+    static const Ops* ops_for()
+    {
+        static const Ops ops = {
+            [] (const void* storage, Args&&... args) -> Result {
+                // callables are invoked as const, just as std::function does
+                return (*static_cast<const Function*>(storage))(
+                        std::forward<Args>(args)...);
+            },
+            [] (void* dst, const void* src) {
+                new (dst) Function(*static_cast<const Function*>(src));
+            },
+            [] (void* dst, void* src) {
+                Function* from = static_cast<Function*>(src);
+                new (dst) Function(std::move(*from));
+                from->~Function();
+            },
+            [] (void* storage) {
+                static_cast<Function*>(storage)->~Function();
+            },
+        };
+        return &ops;
+    }
+
+    template <typename Function>
+    void emplace(Function&& fn)
+    {
+        using Stored = std::decay_t<Function>;
+        static_assert(sizeof(Stored) <= Capacity,
+                "Callable capture is too large for the inline storage");
+        static_assert(alignof(Stored) <= alignof(std::max_align_t),
+                "Callable is over-aligned for the inline storage");
+        static_assert(std::is_copy_constructible_v<Stored>,
+                "Callable must be copyable to support clone()");
+        static_assert(std::is_nothrow_move_constructible_v<Stored>,
+                "Callable must be nothrow movable");
+        new (&m_storage) Stored(std::forward<Function>(fn));
+        m_ops = ops_for<Stored>();
+    }
+
+    alignas(std::max_align_t) unsigned char m_storage[Capacity];
+    const Ops* m_ops;
+};
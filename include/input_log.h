@@ -0,0 +1,62 @@
+#pragma once
+
+#include <SFML/System/Time.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+class OffscreenRenderer;
+
+/**
+ * @struct InputRecord
+ * Player actions (Player::Action bits) triggered during one tick.
+ * @note Written to the log as-is: 8 bytes per tick with input.
+ */
+struct InputRecord {
+    std::uint32_t tick; /**< World tick the actions are executed in. */
+    std::uint32_t actions; /**< Player::Action bitmask. */
+};
+
+/**
+ * @struct InputLog
+ * Recorded game session, the RNG seed, the simulation step and every tick with
+ * player input.
+ */
+struct InputLog {
+    std::uint64_t seed;
+    sf::Time time_per_tick;
+    std::vector<InputRecord> records;
+};
+
+/**
+ * @class InputRecorder
+ * Streams the player actions of a game session into a binary input log, to be
+ * replayed deterministically by run_replay().
+ * @note Log layout: "UGIL" magic, u32 version, u64 seed, i64 microseconds per
+ * tick, then one InputRecord per tick with input (native endianness).
+ */
+class InputRecorder {
+public:
+    InputRecorder(const std::string& filename, std::uint64_t seed,
+            sf::Time time_per_tick);
+    ~InputRecorder();
+
+    void begin_tick(std::uint32_t tick);
+    void record(unsigned int action);
+    void close();
+    std::size_t get_record_count() const;
+private:
+    void flush_tick();
+
+    std::ofstream m_file;
+    std::uint32_t m_tick;
+    std::uint32_t m_actions;
+    std::size_t m_record_count;
+};
+
+InputLog load_input_log(const std::string& filename);
+void run_replay(const std::string& filename,
+        OffscreenRenderer* renderer = nullptr);
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+class DrawList;
+class SceneNode;
+
+/**
+ * @class LayerCache
+ * Caches a static layer as CACHE_TILE_SIZE px render texture tiles. Tiles in
+ * view are rendered once, on first use, and drawn as one sprite each
+ * afterwards, until the layer changes under them (see invalidate()).
+ * @note Least recently drawn tiles are evicted past MAX_TILES. Textures of
+ * invalidated or evicted tiles are kept alive until the last frame recorded
+ * with them is drawn (see DrawList::get_drawn_sequence()), the render thread
+ * may still be drawing them.
+ * @see World::draw()
+ */
+class LayerCache : private sf::NonCopyable {
+public:
+    explicit LayerCache(const sf::FloatRect& bounds);
+
+    bool collect(const SceneNode& layer, DrawList& frame,
+            const sf::FloatRect& view_bounds);
+    void invalidate();
+    void invalidate(const sf::FloatRect& area);
+    std::size_t get_tile_count() const;
+private:
+    /**
+     * @struct Tile
+     * Rendered area of the layer, and the frame it was last drawn in.
+     */
+    struct Tile {
+        std::unique_ptr<sf::RenderTexture> texture;
+        std::uint64_t last_frame;
+    };
+
+    /**
+     * @struct Retired
+     * Texture no longer in the cache, reusable once frame is drawn.
+     */
+    struct Retired {
+        std::unique_ptr<sf::RenderTexture> texture;
+        std::uint64_t frame;
+    };
+
+    /// Tile coordinates (x, y), in tiles from the top left of the bounds.
+    typedef std::pair<int, int> Key;
+
+    std::unique_ptr<sf::RenderTexture> acquire_texture();
+    bool render_tile(const SceneNode& layer, const Key& key,
+            sf::RenderTexture& texture) const;
+    void retire(std::unique_ptr<sf::RenderTexture> texture);
+    void evict();
+
+    sf::FloatRect m_bounds;
+    std::map<Key, Tile> m_tiles;
+    std::vector<Retired> m_retired;
+    /// Sequence number of the frame last collected into, and of the last
+    /// frame drawn when it was begun.
+    std::uint64_t m_frame;
+    std::uint64_t m_drawn_frame;
+    /// Set once a tile fails to render, the layer is drawn uncached from
+    /// then on.
+    bool m_is_failed;
+};
@@ -1,8 +1,8 @@
 #pragma once
 
 namespace Maps {
-    constexpr int MAP_WIDTH 1280;
-    constexpr int MAP_HEIGHT 960;
+    constexpr int MAP_WIDTH = 1280;
+    constexpr int MAP_HEIGHT = 960;
 }
 
 namespace Tiles {
@@ -10,7 +10,9 @@ namespace Tiles {
     constexpr int TILE_WIDTH = 64;
     constexpr int TILE_HEIGHT = 64;
     constexpr int TOTAL_TILES = 192;
-    constexpr int TOTAL_TILE_SPRITES 12;
+    constexpr int TOTAL_TILE_SPRITES = 12;
+    // tiles per side of a TileMap chunk, a chunk is baked in one vertex buffer
+    constexpr int CHUNK_TILES = 16;
 
     enum ID {
         Grass,
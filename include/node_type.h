@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+
+// scene node type tag, used to downcast scene nodes without RTTI
+namespace NodeType {
+    enum Type : std::uint16_t {
+        // bit-wise, the tag of a derived type holds the bits of all its bases,
+        // so "is a" is one mask & compare
+        SceneNode = 1 << 0,
+        Entity = SceneNode | 1 << 1,
+        Creature = Entity | 1 << 2,
+        Projectile = Entity | 1 << 3,
+        Pickup = Entity | 1 << 4,
+        SpriteNode = SceneNode | 1 << 5,
+        TextNode = SceneNode | 1 << 6,
+        TileMap = SceneNode | 1 << 7,
+    };
+}
+
+/**
+ * Checked downcast of a scene node, by its NodeType tag.
+ * @return Returns node as T*, nullptr if node is not a T.
+ * @note T declares its tag as static constexpr NodeType::Type NODE_TYPE.
+ */
+template <typename T, typename Node>
+T* node_cast(Node* node)
+{
+    if (node == nullptr
+            || (node->get_node_type() & T::NODE_TYPE) != T::NODE_TYPE)
+        return nullptr;
+    return static_cast<T*>(node);
+}
+
+/**
+ * Downcast of a scene node expected to be a T, asserted by its NodeType tag.
+ */
+template <typename T, typename Node>
+T& node_cast(Node& node)
+{
+    assert((node.get_node_type() & T::NODE_TYPE) == T::NODE_TYPE);
+    return static_cast<T&>(node);
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "draw_list.h"
+
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace sf {
+    class Image;
+}
+class World;
+
+/**
+ * @class OffscreenRenderer
+ * Renders World into a render texture, without a window, for benchmarks and
+ * image regression checks on machines with no monitor. Each rendered frame
+ * is timed and its pixels hashed, so both slower frames and changed pixels
+ * (e.g. by batching or culling bugs) show up between runs.
+ * @note Frames are rendered at tick boundaries (interpolation 1), the same
+ * replay renders the same frames.
+ * @attention On Linux an X display is still needed for OpenGL, use xvfb-run
+ * on machines without one.
+ * @see run_replay(), run_horde()
+ */
+class OffscreenRenderer : private sf::NonCopyable {
+public:
+    /**
+     * @struct Frame
+     * Statistics of one rendered frame.
+     */
+    struct Frame {
+        std::uint32_t tick;
+        /// Time spent recording the world into a DrawList.
+        sf::Time record_time;
+        /// Time spent drawing the DrawList and reading the pixels back, the
+        /// read back waits for the GPU to finish the frame.
+        sf::Time render_time;
+        std::uint64_t hash;
+    };
+
+    OffscreenRenderer(unsigned int width, unsigned int height);
+
+    const Frame& render(World& world);
+    const std::vector<Frame>& get_frames() const;
+    std::uint64_t get_combined_hash() const;
+    void write_report(std::ostream& out) const;
+    void write_report(const std::string& filename) const;
+    void print_summary(std::ostream& out) const;
+private:
+    /// Created after checking for a display, SFML aborts without one.
+    std::unique_ptr<sf::RenderTexture> m_texture;
+    DrawList m_frame;
+    std::vector<Frame> m_frames;
+};
+
+std::uint64_t hash_image(const sf::Image& image);
@@ -2,16 +2,17 @@
 
 #include "entity.h"
 #include "command.h"
+#include "effect.h"
 #include "r_ids.h"
 #include "r_holders.h"
 
 #include <SFML/Graphics/Sprite.hpp>
 
-// forward Creature class to use in implementation
-class Creature;
-
 class Pickup : public Entity {
 public:
+    /// Tag of Pickup, see node_cast().
+    static constexpr NodeType::Type NODE_TYPE = NodeType::Pickup;
+
     /**
      * @enum Type
      * Type of pickup entity.
@@ -25,11 +26,14 @@ public:
     virtual unsigned int get_category() const;
     virtual sf::FloatRect get_bounding_rect() const;
 
-    void apply(Creature& player) const;
+    Effect get_effect() const;
 protected:
 /// draw_current() protected so derived classes can inherit, but still behaves private.
     virtual void draw_current(sf::RenderTarget& target, sf::RenderStates state)
         const;
+    virtual void collect_current(SpriteBatch& batch,
+            const sf::Transform& transform) const;
+    virtual sf::FloatRect get_cull_bounds() const;
 private:
     Type m_type;
     sf::Sprite m_sprite;
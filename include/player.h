@@ -3,6 +3,7 @@
 //#define SFML_STATIC
 
 #include "command.h"
+#include "entity_handle.h"
 
 #include <SFML/Window/Event.hpp>
 
@@ -10,6 +11,7 @@
 
 /** @brief Forward definition of CommandQueue to be used in implementation. */
 class CommandQueue;
+class InputRecorder;
 
 /**
  * @class Player
@@ -52,6 +54,11 @@ public:
     void handle_event(const sf::Event& event, CommandQueue& commands);
     // for real-time input
     void handle_realtime_input(CommandQueue& commands);
+    // for recorded input
+    void replay_actions(unsigned int actions, CommandQueue& commands);
+    void set_recorder(InputRecorder* recorder);
+    InputRecorder* get_recorder() const;
+    void set_target(EntityHandle target);
     // fn to bind keys and get assigned keys
     void assign_key(Action action, sf::Keyboard::Key key);
     sf::Keyboard::Key get_assigned_key(Action action) const;
@@ -61,6 +68,8 @@ public:
     char* print_assigned_key(Action action) const;
 private:
     void initialize_actions();
+    void trigger_action(Action action, CommandQueue& commands);
+    void push_intent(unsigned int actions, CommandQueue& commands);
     static bool is_realtime_action(Action action);
 
     /**
@@ -84,4 +93,17 @@ private:
      * Holds current level status of Player.
      */
     LevelStatus m_current_level_status;
+
+    /**
+     * @var InputRecorder* m_recorder
+     * Records triggered actions if set, nullptr if not recording.
+     */
+    InputRecorder* m_recorder;
+
+    /**
+     * @var EntityHandle m_target
+     * Player creature that commands are addressed to, invalid to broadcast
+     * to Category::Player.
+     */
+    EntityHandle m_target;
 };
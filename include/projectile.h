@@ -8,6 +8,9 @@
 
 class Projectile : public Entity {
 public:
+    /// Tag of Projectile, see node_cast().
+    static constexpr NodeType::Type NODE_TYPE = NodeType::Projectile;
+
     /**
      * @enum Type
      * Type of projectile entity.
@@ -22,6 +25,9 @@ public:
     Projectile(Type type, const TextureHolder& textures);
     void guide_torwards(sf::Vector2f position);
     bool is_guided() const;
+    bool is_retargeting() const;
+    void reset_retarget_countdown();
+    float get_guide_range() const;
     virtual unsigned int get_category() const;
     virtual sf::FloatRect get_bounding_rect() const;
     float get_max_speed() const;
@@ -30,8 +36,13 @@ private:
     virtual void update_current(sf::Time delta_time, CommandQueue& commands);
     virtual void draw_current(sf::RenderTarget& target, sf::RenderStates states)
         const;
+    virtual void collect_current(SpriteBatch& batch,
+            const sf::Transform& transform) const;
+    virtual sf::FloatRect get_cull_bounds() const;
 
     Type m_type;
     sf::Sprite m_sprite;
-    sf::Vector2f m_target_direction;
+    sf::Vector2f m_target_position;
+    bool m_has_target;
+    sf::Time m_retarget_countdown;
 };
@@ -5,15 +5,39 @@
 
 #include "r_ids.h"
 
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+
 #include <map>
 #include <string>
 #include <memory>
 #include <stdexcept>
 #include <cassert>
+#include <vector>
+
+/**
+ * @struct TextureRegion
+ * Sub-rect of a texture, e.g. an image packed into an atlas page.
+ */
+struct TextureRegion {
+    const sf::Texture* texture;
+    sf::IntRect rect;
+};
 
+/**
+ * @class TextureHolder
+ * Holds standalone textures (load()) and atlas regions (load_region()), rect
+ * packed into a few atlas pages by build_atlas(), so that sprites of
+ * different IDs share a texture and batch together.
+ * @note Textures that are repeated (e.g. tiled backgrounds) must stay
+ * standalone.
+ */
 class TextureHolder {
 public:
     void load(Textures::ID id, const std::string& filename);
+    void load_region(Textures::ID id, const std::string& filename);
+    void build_atlas();
 
     // overloaded load, T can be either sf::Shader::Type or const std::string&
     // for vertex & fragment shader
@@ -23,10 +47,19 @@ public:
 
     sf::Texture& get(Textures::ID id);
     const sf::Texture& get(Textures::ID id) const;
+    const TextureRegion& get_region(Textures::ID id) const;
+    sf::Sprite make_sprite(Textures::ID id) const;
 private:
     void insert_texture(Textures::ID id, std::unique_ptr<sf::Texture> texture);
 
     std::map<Textures::ID, std::unique_ptr<sf::Texture>> m_texture_map;
+    std::map<Textures::ID, TextureRegion> m_region_map;
+    /// Atlas pages, region textures point into these.
+    std::vector<std::unique_ptr<sf::Texture>> m_atlas_pages;
+    /// Images waiting to be packed by build_atlas(), one per filename.
+    std::map<std::string, sf::Image> m_pending_images;
+    /// IDs waiting for their region, and the filename they address.
+    std::map<Textures::ID, std::string> m_pending_regions;
 };
 
 // same implementation as texture holder - recreate as necessary
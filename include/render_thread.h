@@ -0,0 +1,61 @@
+#pragma once
+
+#include "draw_list.h"
+
+#include <SFML/System/NonCopyable.hpp>
+
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+namespace sf {
+    class RenderWindow;
+}
+
+/**
+ * @class RenderThread
+ * Draws and displays frames on its own thread, so that a slow update does not
+ * delay display() and a slow display() (v-sync) does not delay the next
+ * update.
+ * @note Frames are triple buffered: the simulation records into the back
+ * frame, publish() swaps it with the pending frame, and the render thread
+ * swaps the pending frame with the front frame it draws. Neither side waits
+ * for the other, frames not drawn in time are replaced by newer ones.
+ * @attention While started, the window's OpenGL context belongs to the render
+ * thread: other threads must not draw to or close the window.
+ */
+class RenderThread : private sf::NonCopyable {
+public:
+    explicit RenderThread(sf::RenderWindow& window);
+    ~RenderThread();
+
+    void start();
+    void stop();
+    DrawList& begin_frame();
+    void publish();
+    void wait_idle();
+private:
+    void run();
+
+    sf::RenderWindow& m_window;
+    std::array<DrawList, 3> m_frames;
+    /// Frame recorded by the simulation.
+    std::size_t m_back;
+    /// Frame published and not yet drawn, if m_has_pending.
+    std::size_t m_pending;
+    /// Frame drawn by the render thread.
+    std::size_t m_front;
+    bool m_has_pending;
+    bool m_running;
+    /// Count of frames published and drawn, for synchronous frames and the
+    /// sequence numbers of frames.
+    std::uint64_t m_published_count;
+    std::uint64_t m_drawn_count;
+    std::mutex m_mutex;
+    std::condition_variable m_frame_published;
+    std::condition_variable m_frame_drawn;
+    std::thread m_thread;
+};
@@ -14,8 +14,9 @@ public:
     GameState(StateStack& stack, Context context);
     ~GameState();
 
-    virtual void draw();
+    virtual void draw(DrawList& frame);
     virtual bool update(sf::Time delta_time);
+    virtual void skip_update();
     virtual bool handle_event(const sf::Event& event);
     // rendering handled by app
 private:
@@ -12,7 +12,7 @@ class LoadingState : public State {
 public:
     LoadingState(StateStack& stack, Context context);
 
-    virtual void draw();
+    virtual void draw(DrawList& frame);
     virtual bool update(sf::Time delta_time);
     virtual bool handle_event(const sf::Event& event);
 
@@ -12,7 +12,7 @@ public:
     MenuState(StateStack& stack, Context context);
     ~MenuState();
 
-    virtual void draw();
+    virtual void draw(DrawList& frame);
     virtual bool update(sf::Time delta_time);
     virtual bool handle_event(const sf::Event& event);
 
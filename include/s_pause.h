@@ -17,7 +17,7 @@ public:
     ~PauseState();
 
     // same virtual fn for every state (behave the same)
-    virtual void draw();
+    virtual void draw(DrawList& frame);
     virtual bool update(sf::Time delta_time);
     virtual bool handle_event(const sf::Event& event);
 
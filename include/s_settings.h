@@ -13,7 +13,7 @@ public:
     SettingsState(StateStack& stack, Context context);
     ~SettingsState();
 
-    virtual void draw();
+    virtual void draw(DrawList& frame);
     virtual bool update(sf::Time delta_time);
     virtual bool handle_event(const sf::Event& event);
 
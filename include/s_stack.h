@@ -20,6 +20,8 @@ namespace sf {
     class RenderWindow;
 }
 
+class DrawList;
+
 class StateStack : private sf::NonCopyable {
 public:
     enum Action {
@@ -35,7 +37,7 @@ public:
     void register_state(States::ID state_id);
 
     void update(sf::Time delta_time);
-    void draw();
+    void draw(DrawList& frame);
     void handle_event(const sf::Event& event);
 
     void push_state(States::ID state_id);
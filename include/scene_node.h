@@ -3,6 +3,7 @@
 //#define SFML_STATIC
 
 #include "category.h"
+#include "node_type.h"
 
 #include <SFML/System/NonCopyable.hpp>
 #include <SFML/System/Time.hpp>
@@ -19,6 +20,10 @@ namespace sf {
     class RenderTarget;
 }
 
+/** @brief Forward declaration of SpriteBatch to be used in implementation. */
+class SpriteBatch;
+/** @brief Forward declaration of DebugDraw to be used in implementation. */
+class DebugDraw;
 /** @brief Forward declaration of Command to be used in implementation. */
 struct Command;
 /** @brief Forward declaration of CommandQueue to be used in implementation. */
@@ -42,25 +47,41 @@ public:
      */
     typedef std::pair<SceneNode*, SceneNode*> Pair;
 
-    explicit SceneNode(Category::Type category = Category::None);
+    /// Tag of SceneNode, see node_cast().
+    static constexpr NodeType::Type NODE_TYPE = NodeType::SceneNode;
+
+    explicit SceneNode(Category::Type category = Category::None,
+            NodeType::Type node_type = NODE_TYPE);
 
     void attach_child(Ptr child);
     Ptr detach_child(const SceneNode& node);
+    void detach_children(std::vector<SceneNode*>::iterator first,
+            std::vector<SceneNode*>::iterator last, std::vector<Ptr>& detached);
+    SceneNode* get_parent() const;
+    std::size_t get_child_count() const;
     // update scene
     void update(sf::Time delta_time, CommandQueue& commands);
+    // store positions of the scene, interpolated from when drawing
+    void store_previous_positions();
+    // collect scene into sprite batch, instead of drawing node by node
+    void collect(SpriteBatch& batch, const sf::Transform& transform) const;
+    // collect bounds (and more, see debug_draw_current()) of the scene into
+    // debug draw
+    void collect_debug(DebugDraw& debug, const sf::Transform& transform,
+            float interpolation) const;
     // absolute transformations
     sf::Transform get_world_transform() const;
     sf::Vector2f get_world_position() const;
     // virtual method that returns category of the game obj
     virtual unsigned int get_category() const;
+    // non-virtual method that returns type tag of the node, for node_cast()
+    NodeType::Type get_node_type() const { return m_node_type; }
     // non-virtual method, pass command to scene graph
     void on_command(const Command& command, sf::Time dt);
     void check_node_collision(SceneNode& node, std::set<Pair>& collision_pairs);
     void check_scene_collision(SceneNode& scene_graph,
             std::set<Pair>& collision_pairs);
-    virtual bool is_marked_for_removal() const;
     virtual bool is_destroyed() const;
-    void removal();
     sf::FloatRect get_bounding_rect() const;
 private:
     // to be overwritten by derived classes
@@ -69,15 +90,29 @@ private:
     virtual void draw_current(sf::RenderTarget& target, sf::RenderStates states)
         const;
     void draw_children(sf::RenderTarget& target, sf::RenderStates states) const;
+    // only collect current object, to be overwritten by derived classes
+    virtual void collect_current(SpriteBatch& batch,
+            const sf::Transform& transform) const;
+    // local bounds of the node and its children for culling, empty if never
+    // culled
+    virtual sf::FloatRect get_cull_bounds() const;
     // update parent
     virtual void update_current(sf::Time dt, CommandQueue& commands);
     void update_children(sf::Time dt, CommandQueue& commands);
-    void draw_bounding_rect(sf::RenderTarget& target, sf::RenderStates states)
-        const;
+    // only collect debug shapes of current object besides its bounds, to be
+    // overwritten by derived classes
+    virtual void debug_draw_current(DebugDraw& debug,
+            const sf::Transform& transform) const;
+    sf::Transform get_interpolated_transform(float interpolation) const;
 
     std::vector<Ptr> m_children;
     SceneNode* m_parent;
     Category::Type m_default_category;
+    NodeType::Type m_node_type;
+    /// Position at the start of the current tick, see
+    /// store_previous_positions().
+    sf::Vector2f m_previous_position;
+    bool m_has_previous_position;
 };
 
 bool collision(const SceneNode& lhs, const SceneNode& rhs);
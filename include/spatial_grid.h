@@ -0,0 +1,75 @@
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include <SFML/Graphics/Rect.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class SceneNode;
+
+/**
+ * @class SpatialGrid
+ * Uniform grid over the world bounds, indexing scene nodes by position for
+ * nearest and radius queries. Rebuilt every tick: clear(), insert() every
+ * node, then query - the grid is built on the first query.
+ * @note Cells are stored contiguously (counting sort by cell), so a rebuild is
+ * O(n) and keeps its capacity between ticks. Positions outside the bounds are
+ * clamped to the border cells.
+ */
+class SpatialGrid {
+public:
+    /**
+     * @struct Item
+     * Indexed scene node and the position it was indexed at.
+     */
+    struct Item {
+        SceneNode* node;
+        sf::Vector2f position;
+    };
+
+    /**
+     * @struct Cell
+     * Bounds of a grid cell and the count of nodes indexed in it.
+     */
+    struct Cell {
+        sf::FloatRect bounds;
+        std::size_t count;
+    };
+
+    SpatialGrid(const sf::FloatRect& bounds, float cell_size);
+
+    void clear();
+    void insert(SceneNode* node, sf::Vector2f position);
+
+    SceneNode* query_nearest(sf::Vector2f position, float radius);
+    void query_radius(sf::Vector2f position, float radius,
+            std::vector<Item>& items);
+    void query_k_nearest(sf::Vector2f position, float radius, std::size_t k,
+            std::vector<Item>& items);
+    void query_occupied_cells(const sf::FloatRect& area,
+            std::vector<Cell>& cells);
+
+    std::size_t size() const;
+    sf::FloatRect get_bounds() const;
+    float get_cell_size() const;
+private:
+    void build();
+    std::size_t to_cell(sf::Vector2f position) const;
+    std::int32_t to_column(float x) const;
+    std::int32_t to_row(float y) const;
+
+    sf::FloatRect m_bounds;
+    float m_cell_size;
+    std::int32_t m_columns;
+    std::int32_t m_rows;
+    /// Items in insertion order, until build().
+    std::vector<Item> m_pending;
+    /// Items sorted by cell, cell i is [m_cell_start[i], m_cell_start[i + 1]).
+    std::vector<Item> m_items;
+    std::vector<std::size_t> m_cell_start;
+    /// Next free index of each cell, only used in build().
+    std::vector<std::size_t> m_cell_next;
+    bool m_is_built;
+};
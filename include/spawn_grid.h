@@ -0,0 +1,57 @@
+#pragma once
+
+#include "creature.h"
+
+#include <SFML/System/Vector2.hpp>
+#include <SFML/Graphics/Rect.hpp>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @struct SpawnPoint
+ * Spawn point struct, with Creature::Type and sf::Vector2f (x, y)
+ * coordinates for spawn.
+ */
+struct SpawnPoint {
+    SpawnPoint(Creature::Type type, const sf::Vector2f& vec2) :
+        type(type), vec2(vec2) {}
+    Creature::Type type;
+    sf::Vector2f vec2;
+};
+
+/**
+ * @class SpawnGrid
+ * Spawn points indexed in a grid keyed by chunk, so that only the chunks
+ * around an area are looked at - cost is O(nearby) instead of O(spawn points).
+ */
+class SpawnGrid {
+public:
+    explicit SpawnGrid(float chunk_size);
+
+    void insert(const SpawnPoint& spawn);
+    void pop_in(const sf::FloatRect& area, std::vector<SpawnPoint>& spawns);
+    std::size_t size() const;
+    bool is_empty() const;
+private:
+    /**
+     * @struct ChunkRange
+     * Inclusive range of chunk coordinates.
+     */
+    struct ChunkRange {
+        std::int32_t left, top, right, bottom;
+        bool operator==(const ChunkRange& rhs) const = default;
+    };
+
+    std::int32_t to_chunk(float coord) const;
+    static std::uint64_t to_key(std::int32_t x, std::int32_t y);
+
+    float m_chunk_size;
+    std::unordered_map<std::uint64_t, std::vector<SpawnPoint>> m_chunks;
+    std::size_t m_size;
+    /// Last range popped, nothing new can be found until it changes or a spawn
+    /// point is inserted.
+    ChunkRange m_last_range;
+    bool m_is_last_range_valid;
+};
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "scene_node.h"
+
+#include <vector>
+
+/**
+ * @class SpawnQueue
+ * Entities created during the tick (projectiles, pickups...), inserted into
+ * their layer at one safe point of World::update().
+ * @note Entities are never attached while the scene graph is traversed, and
+ * each entity is attached exactly once, into the layer the queue flushes to.
+ */
+class SpawnQueue {
+public:
+    void push(SceneNode::Ptr node);
+    void flush(SceneNode& layer);
+    std::size_t get_pending_count() const;
+private:
+    std::vector<SceneNode::Ptr> m_pending;
+};
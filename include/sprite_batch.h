@@ -0,0 +1,89 @@
+#pragma once
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace sf {
+    class Drawable;
+    class Sprite;
+    class Text;
+    class Texture;
+}
+
+class DrawList;
+
+/**
+ * @class SpriteBatch
+ * Collects the sprites of a draw pass as textured quads, one vertex batch per
+ * texture, so that a layer is drawn with one draw call per distinct texture
+ * instead of one per sprite.
+ * @note Drawables that are not sprites (e.g. texts) are drawn one by one after
+ * the batches, on top.
+ * @note Batches are recorded into a DrawList, drawn later by the render
+ * thread.
+ * @note Nodes outside the cull rect are skipped with their children, see
+ * set_cull_rect().
+ * @see SceneNode::collect()
+ */
+class SpriteBatch {
+public:
+    SpriteBatch();
+
+    void clear();
+    void add(const sf::Sprite& sprite, const sf::Transform& transform);
+    void add(const sf::Vertex* vertices, std::size_t count,
+            const sf::Texture* texture, const sf::Transform& transform);
+    void add(const sf::Text& text, const sf::Transform& transform);
+    void add(const sf::Drawable& drawable, const sf::Transform& transform,
+            const sf::Texture* texture = nullptr);
+    void draw(DrawList& frame) const;
+    std::size_t get_draw_call_count() const;
+    void set_cull_rect(const sf::FloatRect& rect);
+    const sf::FloatRect& get_cull_rect() const;
+    bool cull(const sf::FloatRect& bounds);
+    std::size_t get_culled_count() const;
+    void set_interpolation(float interpolation);
+    float get_interpolation() const;
+private:
+    /**
+     * @struct Batch
+     * Triangles of all quads sharing texture.
+     */
+    struct Batch {
+        const sf::Texture* texture;
+        std::vector<sf::Vertex> vertices;
+    };
+
+    /**
+     * @struct Fallback
+     * Drawable drawn on its own, with its absolute transform and the texture
+     * of its states, if any (e.g. vertex buffers). Texts are kept apart, to
+     * be copied into the frame.
+     */
+    struct Fallback {
+        const sf::Drawable* drawable;
+        const sf::Text* text;
+        sf::Transform transform;
+        const sf::Texture* texture;
+    };
+
+    Batch& get_batch(const sf::Texture* texture);
+
+    /// Batches are reused between passes, the first m_batch_count are in use.
+    std::vector<Batch> m_batches;
+    std::size_t m_batch_count;
+    /// Index of the last batch added to, sprites often share a texture.
+    std::size_t m_last_batch;
+    std::vector<Fallback> m_fallbacks;
+    /// Absolute area collected, an empty rect disables culling.
+    sf::FloatRect m_cull_rect;
+    /// Nodes culled since clear(), not counting their children.
+    std::size_t m_culled_count;
+    /// Fraction of a tick elapsed since the last update, nodes are collected
+    /// at their position interpolated by it.
+    float m_interpolation;
+};
@@ -8,11 +8,16 @@
 // redraw sprite, can be accessed through sprite node
 class SpriteNode : public SceneNode {
 public:
+    /// Tag of SpriteNode, see node_cast().
+    static constexpr NodeType::Type NODE_TYPE = NodeType::SpriteNode;
+
     explicit SpriteNode(const sf::Texture& texture);
     SpriteNode(const sf::Texture& texture, const sf::IntRect& texture_rect);
 private:
     virtual void draw_current(sf::RenderTarget& target, sf::RenderStates states)
         const;
+    virtual void collect_current(SpriteBatch& batch,
+            const sf::Transform& transform) const;
     // sf::Sprite prepared at startup and not touched again
     sf::Sprite m_sprite;
 };
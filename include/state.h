@@ -16,6 +16,8 @@
 
 class StateStack;
 class Player;
+class DrawList;
+class RenderThread;
 
 class State {
 public:
@@ -27,20 +29,27 @@ public:
     // to views dimensions
     struct Context {
         Context(sf::RenderWindow& window, TextureHolder& textures,
-                FontHolder& fonts, Player& player);
+                FontHolder& fonts, Player& player,
+                RenderThread& render_thread);
         sf::RenderWindow *window;
         TextureHolder *textures;
         FontHolder *fonts;
         Player *player;
+        // draws the frames states record, which point into the states
+        RenderThread *render_thread;
     };
 
     State(StateStack& stack, Context context);
     virtual ~State();
 
     // virtual fn for every state to inherit (and use)
-    virtual void draw() = 0;
+    // records the state into frame, drawn by the render thread
+    virtual void draw(DrawList& frame) = 0;
     virtual bool update(sf::Time delta_time) = 0;
     virtual bool handle_event(const sf::Event& event) = 0;
+    // called instead of update when a state above stops the update (e.g.
+    // pause), states that interpolate their drawing hold it still
+    virtual void skip_update();
 
     // non-virtual clear fn for each state to use to clear screen (if desired)
     //void clear();
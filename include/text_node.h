@@ -4,16 +4,42 @@
 #include "r_ids.h"
 #include "scene_node.h"
 
-#include <SFML/Graphics/Text.hpp>
+#include <SFML/Graphics/Color.hpp>
 #include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+
+#include <string>
+#include <vector>
 
 // text node is a derivative of scene node
+// glyph quads are cached and only rebuilt when the string changes, texts are
+// batched per font page like sprites
 class TextNode : public SceneNode {
 public:
+    /// Tag of TextNode, see node_cast().
+    static constexpr NodeType::Type NODE_TYPE = NodeType::TextNode;
+
     explicit TextNode(const FontHolder& fonts, const std::string& text);
     void set_string(const std::string& text);
+    const std::string& get_string() const;
 private:
     virtual void draw_current(sf::RenderTarget& target, sf::RenderStates states)
         const;
-    sf::Text m_text;
+    virtual void collect_current(SpriteBatch& batch,
+            const sf::Transform& transform) const;
+    void build_geometry();
+
+    const sf::Font& m_font;
+    unsigned int m_character_size;
+    std::string m_string;
+    /// Glyph quads of m_string as triangles, centered on the node, textured
+    /// by the font page of m_character_size.
+    std::vector<sf::Vertex> m_vertices;
 };
+
+sf::FloatRect append_glyph_quads(std::vector<sf::Vertex>& vertices,
+        const sf::Font& font, unsigned int character_size,
+        const std::string& text, sf::Color color = sf::Color::White);
+const sf::Texture& get_glyph_page(const sf::Font& font,
+        unsigned int character_size);
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Time.hpp>
+
+#include <array>
+#include <cstddef>
+#include <ostream>
+
+/**
+ * @class TickProfile
+ * Accumulates the time spent in each phase of World::update(), to report the
+ * per-phase tick cost.
+ */
+class TickProfile {
+public:
+    /**
+     * @enum Phase
+     * Phases of World::update(), in order.
+     */
+    enum Phase : unsigned int {
+        Commands,
+        Collisions,
+        Destructions,
+        Spawns,
+        SceneUpdate,
+        PhaseCount,
+    };
+
+    TickProfile();
+
+    void begin_phase();
+    void end_phase(Phase phase);
+    void end_tick();
+    void reset();
+
+    std::size_t get_tick_count() const;
+    sf::Time get_average(Phase phase) const;
+    sf::Time get_average_tick() const;
+    sf::Time get_max_tick() const;
+
+    static void print_header(std::ostream& out);
+    void print(std::ostream& out) const;
+private:
+    sf::Clock m_clock;
+    std::array<sf::Time, PhaseCount> m_totals;
+    sf::Time m_current_tick;
+    sf::Time m_max_tick;
+    std::size_t m_tick_count;
+};
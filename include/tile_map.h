@@ -0,0 +1,66 @@
+#pragma once
+
+#include "m_ids.h"
+#include "scene_node.h"
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include <vector>
+
+namespace sf {
+    class Texture;
+}
+
+/**
+ * @class TileMap
+ * Grid of Tiles::TILE_WIDTH x Tiles::TILE_HEIGHT tiles, stored in chunks of
+ * Tiles::CHUNK_TILES x Tiles::CHUNK_TILES tiles. Each chunk is baked into one
+ * static sf::VertexBuffer, rebuilt only when one of its tiles changes, and
+ * only chunks in view are drawn - one draw call per visible chunk.
+ * @note The tileset holds one tile per Tiles::ID, left to right and top to
+ * bottom, in cells of the tile size. A repeated tileset smaller than a cell
+ * is tiled across the cell.
+ */
+class TileMap : public SceneNode {
+public:
+    /// Tag of TileMap, see node_cast().
+    static constexpr NodeType::Type NODE_TYPE = NodeType::TileMap;
+
+    TileMap(const sf::Texture& tileset, sf::Vector2i size, Tiles::ID fill);
+
+    void set_tile(int x, int y, Tiles::ID id);
+    Tiles::ID get_tile(int x, int y) const;
+    sf::Vector2i get_size() const;
+    void rebuild_dirty_chunks();
+private:
+    /**
+     * @struct Chunk
+     * Tiles of one chunk as quads, on the GPU if vertex buffers are available.
+     */
+    struct Chunk {
+        sf::VertexBuffer buffer;
+        /// Copy of the quads, drawn directly without vertex buffers.
+        std::vector<sf::Vertex> vertices;
+        bool dirty;
+    };
+
+    virtual void update_current(sf::Time dt, CommandQueue& commands);
+    virtual void draw_current(sf::RenderTarget& target, sf::RenderStates states)
+        const;
+    virtual void collect_current(SpriteBatch& batch,
+            const sf::Transform& transform) const;
+    void build_chunk(int chunk_x, int chunk_y);
+    sf::IntRect get_chunk_range(const sf::FloatRect& area) const;
+
+    const sf::Texture& m_tileset;
+    sf::Vector2i m_size;
+    sf::Vector2i m_chunk_count;
+    /// Tile IDs, row by row.
+    std::vector<Tiles::ID> m_tiles;
+    /// Chunks, row by row.
+    std::vector<Chunk> m_chunks;
+    bool m_use_buffers;
+};
@@ -6,24 +6,43 @@
 #include "r_ids.h"
 #include "scene_node.h"
 #include "sprite_node.h"
+#include "tile_map.h"
+#include "layer_cache.h"
 #include "creature.h"
 #include "command_queue.h"
+#include "concurrent_command_queue.h"
 #include "command.h"
 #include "pickup.h"
 #include "projectile.h"
+#include "effect.h"
+#include "destruction_queue.h"
+#include "entity_registry.h"
+#include "spawn_queue.h"
+#include "events.h"
+#include "spawn_grid.h"
+#include "horde.h"
+#include "tick_profile.h"
+#include "spatial_grid.h"
+#include "sprite_batch.h"
+#include "debug_draw.h"
 
 #include <SFML/System/NonCopyable.hpp>
 #include <SFML/Graphics/View.hpp>
 #include <SFML/Graphics/Texture.hpp>
 
 #include <array>
+#include <cstdint>
+#include <memory>
+#include <span>
 #include <queue>
+#include <utility>
 #include <vector>
 
 /// Forward declarations to be used in implementation.
 namespace sf {
 	class RenderWindow;
 }
+class DrawList;
 
 /**
  World must include...
@@ -45,8 +64,18 @@ public:
     explicit World(sf::RenderWindow& window, FontHolder& fonts);
 
     void update(sf::Time dt);
-    void draw();
+    void store_previous_positions();
+    void draw(DrawList& frame);
     CommandQueue& get_command_queue();
+    ConcurrentCommandQueue& get_remote_command_queue();
+    void start_horde(const HordeConfig& config);
+    bool is_horde_finished() const;
+    std::uint32_t get_tick() const;
+    EntityHandle get_player_handle() const;
+    std::size_t get_score() const;
+    std::size_t get_culled_count() const;
+    void set_tile(int x, int y, Tiles::ID id);
+    DebugDraw& get_debug_draw();
 private:
     /** @enum Layer
      * An enum for the world layers.
@@ -57,18 +86,6 @@ private:
         LayerCount
     };
 
-    /**
-     * @struct SpawnPoint
-     * Spawn point struct, with Creature::Type and sf::Vector2f (x, y)
-     * coordinates for spawn.
-     */
-    struct SpawnPoint {
-        SpawnPoint(Creature::Type type, sf::Vector2f& vec2) :
-            type(type), vec2(vec2) {}
-        Creature::Type type;
-        sf::Vector2f vec2;
-    };
-
     void load_textures();
     void build_scene();
 	void adapt_player_position();
@@ -77,15 +94,29 @@ private:
     void add_npcs();
     void add_npc(Creature::Type type, sf::Vector2f& vec2_rel);
     void spawn_npcs();
+    void spawn_npc(const SpawnPoint& spawn);
+    void update_horde(sf::Time dt);
+    void report_horde_level();
     void destroy_entities_outside_chunk();
-    // void guide_projectiles();
+    void subscribe_events();
+    void on_damage(std::span<const Events::Damage> events);
+    void on_pickup_collected(std::span<const Events::PickupCollected> events);
+    void on_creature_died(std::span<const Events::CreatureDied> events);
+    void drop_pickup(sf::Vector2f position);
+    void dispatch_command(const Command& command, sf::Time delta_time);
+    void drain_remote_commands();
+    void guide_projectiles();
     bool matches_categories(SceneNode::Pair& colliders, Category::Type type1,
             Category::Type type2) const;
+    void draw_debug(DrawList& frame, const sf::View& view,
+            float interpolation);
     sf::FloatRect get_view_bounds() const;
     sf::FloatRect get_chunk_bounds() const;
 
     sf::RenderWindow& m_window;
     sf::View m_world_view;
+    /// Center of m_world_view at the start of the tick, for interpolation.
+    sf::Vector2f m_previous_view_center;
     TextureHolder m_textures;
     /// FontHolder is reference and TextureHolder is not because of FontHolder&
     /// in default constructor.
@@ -93,13 +124,60 @@ private:
     SceneNode m_scene_graph;
     /// For scene layers, use array of Ptr with the size LayerCount.
     std::array<SceneNode*, LayerCount> m_scene_layers;
+    /// Static layers are drawn from a cache, nullptr for dynamic layers.
+    std::array<std::unique_ptr<LayerCache>, LayerCount> m_layer_caches;
+    /// Background tiles, owned by the background layer.
+    TileMap* m_tile_map;
 	CommandQueue m_command_queue;
+    /// Count of completed updates, commands pushed between updates are
+    /// executed in tick m_tick.
+    std::uint32_t m_tick;
+    /// Commands pushed from other threads, drained into m_command_queue at
+    /// the start of update().
+    ConcurrentCommandQueue m_remote_commands;
+    /// Gameplay events of the tick, delivered in batches at sync points.
+    GameEventBus m_events;
+    /// Effects of collected pickups, resolved in one pass.
+    EffectBuffer m_effects;
+    /// Count of enemies killed.
+    std::size_t m_score;
+    /// Destroyed entities, in their death effect phase until reclaimed.
+    DestructionQueue m_destructions;
+    /// Live entities by handle, for commands addressed to one entity.
+    EntityRegistry m_entity_registry;
+    /// Entities created this tick, attached to the foreground layer at once.
+    SpawnQueue m_spawns;
+    /// World systems shared with all entities in the world.
+    Entity::Context m_entity_context;
     sf::FloatRect m_world_bounds;
     sf::Vector2f m_player_spawn_point;
     float m_scroll_speed;
     Creature* m_player_creature;
-    /// Holds all future spawn points.
-    std::vector<SpawnPoint> m_npc_spawn_points;
+    /// Holds all future spawn points, indexed by chunk.
+    SpawnGrid m_npc_spawn_grid;
+    /// Spawn points activated this tick, keeps capacity between ticks.
+    std::vector<SpawnPoint> m_npc_spawns;
     /// Holds Ptr to all active NPCs.
     std::vector<Creature*> m_active_npcs;
+    /// Horde stress mode, nullptr unless started.
+    std::unique_ptr<Horde> m_horde;
+    /// Horde spawns of this tick, keep capacity between ticks.
+    std::vector<SpawnPoint> m_horde_creatures;
+    std::vector<sf::Vector2f> m_horde_projectiles;
+    /// Time spent in each phase of update().
+    TickProfile m_tick_profile;
+    /// Live enemies indexed by position, rebuilt every tick for guided
+    /// projectiles to acquire targets.
+    SpatialGrid m_enemy_index;
+    /// Sprites of the layer being drawn, batched by texture.
+    SpriteBatch m_sprite_batch;
+    /// Nodes outside the view skipped by the last draw().
+    std::size_t m_culled_count;
+    /// Debug overlay, drawn over the layers while enabled.
+    DebugDraw m_debug_draw;
+    /// World positions of the collision pairs of the last tick, only kept
+    /// while m_debug_draw is enabled.
+    std::vector<std::pair<sf::Vector2f, sf::Vector2f>> m_debug_contacts;
+    /// Occupied enemy index cells in view, keeps capacity between frames.
+    std::vector<SpatialGrid::Cell> m_debug_cells;
 };
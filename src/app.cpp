@@ -16,20 +16,32 @@
 #include <imgui.h>
 #include <imgui-SFML.h>
 
+#include <algorithm>
 #include <stdexcept>
 #include <iostream>
 
 using namespace conf;
 
-Application::Application() :
+/**
+ * @param sf::Time time_per_tick
+ * Fixed simulation step. Frames are still drawn every TIME_PER_FRAME,
+ * interpolated between ticks, so the tick rate can be lower than the frame
+ * rate.
+ */
+Application::Application(sf::Time time_per_tick) :
+    m_time_per_tick(time_per_tick),
     // default resolution, title, & window style
     m_window(sf::VideoMode(RESOLUTION_X, RESOLUTION_Y, 16), TITLE,
             sf::Style::Close),
     m_textures(),
     m_player(),
     // reused context loading between states
-    m_state_stack(State::Context(m_window, m_textures, m_fonts, m_player)),
-    m_debug()
+    // m_render_thread is constructed later, the stack only keeps its address
+    m_state_stack(State::Context(m_window, m_textures, m_fonts, m_player,
+                m_render_thread)),
+    m_debug(),
+    m_recorder(),
+    m_render_thread(m_window)
 {
     // enable v-sync
     m_window.setVerticalSyncEnabled(VSYNC_TRUE);
@@ -59,6 +71,21 @@ Application::Application() :
     m_state_stack.push_state(States::Title);
 }
 
+/**
+ * Records the input of the first game session into record_filename, with the
+ * RNG seed, to be replayed with --replay.
+ * @see InputRecorder, run_replay()
+ */
+Application::Application(sf::Time time_per_tick,
+        const std::string& record_filename) :
+    Application(time_per_tick)
+{
+    m_recorder.reset(new InputRecorder(record_filename, get_random_seed(),
+                m_time_per_tick));
+    m_player.set_recorder(m_recorder.get());
+    std::cout << "Recording input to " << record_filename << "\n";
+}
+
 void Application::run()
 {
     // debug if loop is entered
@@ -69,6 +96,10 @@ void Application::run()
 
     sf::Clock clock; // game clock
     sf::Time time_since_last_update = sf::Time::Zero;
+    sf::Time time_since_last_render = sf::Time::Zero;
+
+    // from now on, the window is drawn to by the render thread only
+    m_render_thread.start();
 
     // game poll, outer game loop -> variable rendering (as fast as possible)
     // game loop: (1) process_input, (2) update, (3) render
@@ -77,27 +108,30 @@ void Application::run()
         // setup to adjust for timestep
         sf::Time elapsed_time = clock.restart();
         time_since_last_update += elapsed_time;
+        time_since_last_render += elapsed_time;
 
-        // wait for framerate to match expected - fixes delta time issues
-        if (time_since_last_update > TIME_PER_FRAME) {
-            // game logic loop, while framerate matches expected
-            // do first since cond is already checked
-            do {
-            time_since_last_update -= TIME_PER_FRAME;
+        // game logic loop, fixed timestep of m_time_per_tick - fixes delta
+        // time issues
+        while (time_since_last_update > m_time_per_tick) {
+            time_since_last_update -= m_time_per_tick;
             // recieve input and put into command queue
             process_input();
             // update in inner loop
-            update(TIME_PER_FRAME);
-            // confirm further loops by checking cond again
-            } while (time_since_last_update > TIME_PER_FRAME);
-            // NOTE: render needs to be guarded by if cond or else frames out of sync
-            // render after main loop, everything is prepared and ready to render
-            render();
-        // sleep until framerate matches expected
+            update(m_time_per_tick);
+        }
+
+        // render at framerate, between ticks: the leftover time is the
+        // fraction of the next tick to interpolate by
+        if (time_since_last_render > TIME_PER_FRAME) {
+            time_since_last_render = sf::Time::Zero;
+            render(time_since_last_update / m_time_per_tick);
+        // sleep until the next tick or frame, whichever comes first
         } else {
-            sf::sleep(TIME_PER_FRAME - time_since_last_update);
+            sf::sleep(std::min(TIME_PER_FRAME - time_since_last_render,
+                        m_time_per_tick - time_since_last_update));
         }
     }
+    m_render_thread.stop();
     // close gui
     //ImGui::SFML::Shutdown();
 }
@@ -108,8 +142,11 @@ void Application::process_input()
     sf::Event event;
     while (m_window.pollEvent(event)) {
         m_state_stack.handle_event(event);
-        if (event.type == sf::Event::Closed)
+        if (event.type == sf::Event::Closed) {
+            // the render thread must give the context back before closing
+            m_render_thread.stop();
             m_window.close();
+        }
     }
 }
 
@@ -118,17 +155,23 @@ void Application::update(sf::Time delta_time) {
     m_state_stack.update(delta_time);
 }
 
-void Application::render()
+/**
+ * Records the frame (based on state) and hands it to the render thread, which
+ * clears, draws and displays the window while the next updates run.
+ * @param float interpolation
+ * Fraction of a tick elapsed since the last update, see
+ * DrawList::set_interpolation().
+ */
+void Application::render(float interpolation)
 {
-    // clear window
-    m_window.clear();
+    DrawList& frame = m_render_thread.begin_frame();
+    frame.set_interpolation(interpolation);
     // redraw window (based on state)
-    m_state_stack.draw();
+    m_state_stack.draw(frame);
     // default view and display buffered window
     //m_window.setView(m_window.getDefaultView());
     //ImGui::SFML::Render(m_window);
-    //ImGui::SFML::Render(m_window);
-    m_window.display();
+    m_render_thread.publish();
 }
 
 void Application::register_states()
@@ -2,6 +2,17 @@
 
 Command::Command() :
     action(),
-    category(Category::None) // initialize category as none
+    category(Category::None), // initialize category as none
+    target() // initialize target as invalid, broadcast to category
 {
 }
+
+/** Copies action and category of a stored command, to be pushed. */
+Command Command::clone() const
+{
+    Command copy;
+    copy.action = action.clone();
+    copy.category = category;
+    copy.target = target;
+    return copy;
+}
@@ -1,20 +1,91 @@
 #include "command_queue.h"
 #include "scene_node.h"
 
-void CommandQueue::push(const Command& command)
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+namespace {
+    /// Initial capacity of the ring buffer, must be a power of two.
+    constexpr std::size_t INITIAL_CAPACITY = 64;
+}
+
+CommandQueue::CommandQueue() :
+    m_ring(INITIAL_CAPACITY),
+    m_head(0),
+    m_count(0),
+    m_drained(INITIAL_CAPACITY),
+    m_drained_span()
+{
+}
+
+void CommandQueue::push(Command&& command)
 {
-    m_queue.push(command);
+    if (m_count == m_ring.size())
+        grow();
+    // capacity is a power of two, wrap around with a mask
+    std::size_t tail = (m_head + m_count) & (m_ring.size() - 1);
+    m_ring[tail] = std::move(command);
+    ++m_count;
 }
 
 Command CommandQueue::pop()
 {
-    Command command = m_queue.front();
-    m_queue.pop();
+    assert(!is_empty());
+    Command command = std::move(m_ring[m_head]);
+    m_head = (m_head + 1) & (m_ring.size() - 1);
+    --m_count;
     return command;
 }
 
+/**
+ * Hands out all queued commands as one contiguous span, to be executed in
+ * place.
+ * @note The queued commands swap storage with the commands of the last
+ * drain, so commands pushed while the span is being executed are queued for
+ * the next drain. The span is valid until the next call to drain().
+ */
+std::span<Command> CommandQueue::drain()
+{
+    // release captures of commands executed since the last drain
+    for (Command& command : m_drained_span)
+        command.action.reset();
+
+    linearize();
+    m_drained.swap(m_ring);
+    m_drained_span = std::span<Command>(m_drained.data(), m_count);
+    m_head = 0;
+    m_count = 0;
+
+    // the previously drained storage may be smaller than the queued commands
+    if (m_ring.size() < m_drained.size())
+        m_ring.resize(m_drained.size());
+    return m_drained_span;
+}
+
 // check is command queue is empty - t/f
 bool CommandQueue::is_empty() const
 {
-    return m_queue.empty();
+    return m_count == 0;
+}
+
+std::size_t CommandQueue::size() const
+{
+    return m_count;
+}
+
+/** Doubles capacity, moving queued commands to the front of the new ring. */
+void CommandQueue::grow()
+{
+    linearize();
+    m_ring.resize(m_ring.size() * 2);
+}
+
+/** Rotates the ring so that queued commands start at index 0. */
+void CommandQueue::linearize()
+{
+    if (m_head == 0)
+        return;
+    std::rotate(m_ring.begin(), m_ring.begin() + m_head, m_ring.end());
+    m_head = 0;
 }
@@ -0,0 +1,215 @@
+#include "concurrent_command_queue.h"
+#include "command_queue.h"
+#include "scene_node.h"
+
+#include <SFML/System/Clock.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+    /// Capacity of the stress test queue, small so that it wraps and fills.
+    constexpr std::size_t STRESS_CAPACITY = 1024;
+
+    /**
+     * @struct StressCheck
+     * Consumer side of run_command_stress(), only touched by the draining
+     * thread, from the commands' actions.
+     */
+    struct StressCheck {
+        /// Index of the next command expected from each producer.
+        std::vector<std::size_t> next;
+        std::size_t received = 0;
+        std::size_t out_of_order = 0;
+
+        void receive(std::size_t producer, std::size_t index)
+        {
+            if (index != next[producer])
+                ++out_of_order;
+            next[producer] = index + 1;
+            ++received;
+        }
+    };
+}
+
+/**
+ * @param std::size_t capacity
+ * Number of slots, must be a power of two.
+ */
+ConcurrentCommandQueue::ConcurrentCommandQueue(std::size_t capacity) :
+    m_slots(new Slot[capacity]),
+    m_mask(capacity - 1),
+    m_enqueue_pos(0),
+    m_dequeue_pos(0),
+    m_peak_drained(0),
+    m_pushed(0),
+    m_rejected(0),
+    m_rejected_since_drain(0)
+{
+    assert(capacity >= 2 && (capacity & m_mask) == 0);
+    // slot i is free for the producer that claims position i
+    for (std::size_t i = 0; i < capacity; ++i)
+        m_slots[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+/**
+ * Pushes command from any thread.
+ * @return Returns true if command was queued, false if the queue is full. On
+ * failure command is left untouched, so the producer may retry or drop it.
+ */
+bool ConcurrentCommandQueue::try_push(Command&& command)
+{
+    std::size_t pos = m_enqueue_pos.load(std::memory_order_relaxed);
+    Slot* slot;
+    for (;;) {
+        slot = &m_slots[pos & m_mask];
+        std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        std::intptr_t diff = static_cast<std::intptr_t>(sequence)
+            - static_cast<std::intptr_t>(pos);
+        if (diff == 0) {
+            // slot is free, claim it (pos is reloaded on failure)
+            if (m_enqueue_pos.compare_exchange_weak(pos, pos + 1,
+                        std::memory_order_relaxed))
+                break;
+        } else if (diff < 0) {
+            // slot still holds the command of the previous lap, queue is full
+            m_rejected.fetch_add(1, std::memory_order_relaxed);
+            m_rejected_since_drain.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            // another producer claimed the slot first
+            pos = m_enqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
+    slot->command = std::move(command);
+    // publish the command to the consumer
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    m_pushed.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+/**
+ * Moves all published commands into commands, in push order.
+ * @attention Must only be called by the simulation thread.
+ * @return Returns the number of commands drained.
+ */
+std::size_t ConcurrentCommandQueue::drain_into(CommandQueue& commands)
+{
+    std::size_t drained = 0;
+    for (;;) {
+        Slot& slot = m_slots[m_dequeue_pos & m_mask];
+        std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        // a slot claimed but not yet published stops the drain, so that
+        // commands are never reordered
+        if (sequence != m_dequeue_pos + 1)
+            break;
+        commands.push(std::move(slot.command));
+        // free the slot for the producer of the next lap
+        slot.sequence.store(m_dequeue_pos + m_mask + 1,
+                std::memory_order_release);
+        ++m_dequeue_pos;
+        ++drained;
+    }
+    m_peak_drained = std::max(m_peak_drained, drained);
+    m_rejected_since_drain.store(0, std::memory_order_relaxed);
+    return drained;
+}
+
+ConcurrentCommandQueue::Stats ConcurrentCommandQueue::get_stats() const
+{
+    return Stats{
+        m_mask + 1,
+        m_pushed.load(std::memory_order_relaxed),
+        m_rejected.load(std::memory_order_relaxed),
+        m_rejected_since_drain.load(std::memory_order_relaxed),
+        m_peak_drained,
+    };
+}
+
+/**
+ * Stress test of ConcurrentCommandQueue: producer_count threads push
+ * command_count commands each, retrying while the queue is full, and the
+ * calling thread drains them into a CommandQueue and runs them, like World
+ * does every tick. Meant to be run under ThreadSanitizer.
+ * @return Returns true if every command arrived exactly once and in the order
+ * its producer pushed it. Prints the statistics of the run into out.
+ */
+bool run_command_stress(std::size_t producer_count, std::size_t command_count,
+        std::ostream& out)
+{
+    ConcurrentCommandQueue queue(STRESS_CAPACITY);
+    CommandQueue commands;
+    StressCheck check;
+    check.next.assign(producer_count, 0);
+    SceneNode node;
+    std::atomic<bool> is_started(false);
+    std::atomic<std::size_t> finished_count(0);
+    std::atomic<std::size_t> retries(0);
+
+    std::vector<std::thread> producers;
+    for (std::size_t producer = 0; producer < producer_count; ++producer) {
+        producers.emplace_back([&, producer] {
+            while (!is_started.load(std::memory_order_acquire))
+                std::this_thread::yield();
+            std::size_t producer_retries = 0;
+            for (std::size_t index = 0; index < command_count; ++index) {
+                Command command;
+                StressCheck* checker = &check;
+                command.action = [checker, producer, index] (SceneNode&,
+                        sf::Time) {
+                    checker->receive(producer, index);
+                };
+                // command is left untouched by a failed push
+                while (!queue.try_push(std::move(command))) {
+                    ++producer_retries;
+                    std::this_thread::yield();
+                }
+            }
+            retries.fetch_add(producer_retries, std::memory_order_relaxed);
+            finished_count.fetch_add(1, std::memory_order_release);
+        });
+    }
+
+    sf::Clock clock;
+    is_started.store(true, std::memory_order_release);
+    std::size_t drains = 0;
+    for (;;) {
+        // once all producers are finished, one more drain gets the rest, a
+        // lost command shows up as missing instead of waiting forever
+        bool is_finished = finished_count.load(std::memory_order_acquire)
+            == producer_count;
+        if (queue.drain_into(commands) == 0) {
+            if (is_finished)
+                break;
+            std::this_thread::yield();
+            continue;
+        }
+        ++drains;
+        for (Command& command : commands.drain())
+            command.action(node, sf::Time::Zero);
+    }
+    sf::Time elapsed = clock.getElapsedTime();
+    for (std::thread& producer : producers)
+        producer.join();
+
+    const std::size_t total = producer_count * command_count;
+
+    ConcurrentCommandQueue::Stats stats = queue.get_stats();
+    bool is_complete = stats.pushed == total && check.received == total;
+    for (std::size_t next : check.next)
+        is_complete = is_complete && next == command_count;
+    out << "Command stress: " << producer_count << " producers x "
+        << command_count << " commands, capacity " << stats.capacity << ", "
+        << elapsed.asMilliseconds() << " ms\n"
+        << "  received " << check.received << " of " << total
+        << ", out of order " << check.out_of_order << "\n"
+        << "  full queue retries " << retries.load() << " (rejected "
+        << stats.rejected << "), drains " << drains << ", peak drained "
+        << stats.peak_drained << std::endl;
+    return is_complete && check.out_of_order == 0
+        && stats.rejected == retries.load();
+}
@@ -1,14 +1,17 @@
 //#define SFML_STATIC
 
 #include "creature.h"
+#include "sprite_batch.h"
 #include "data_tables.h"
 #include "utility.h"
+#include "events.h"
 
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/RenderStates.hpp>
 
 #include <cmath>
 #include <iostream>
+#include <limits>
 #include <string>
 #include <stdexcept>
 
@@ -16,36 +19,43 @@
 /// data TABLE local to Creature.
 namespace {
     const std::vector<CreatureData> TABLE = initialize_creature_data();
+
+    /// Command prototype applying fn to the creature it is addressed to.
+    template <typename Function>
+    Command make_prototype(Function fn)
+    {
+        Command prototype;
+        prototype.category = Category::Creature;
+        prototype.action = derived_action<Creature>(fn);
+        return prototype;
+    }
 }
 
+/**
+ * Launches a projectile from the creature.
+ * @note Captures nothing, cloning the prototype copies no per-creature state.
+ */
+const Command Creature::ATTACK_PROTOTYPE = make_prototype(
+        [] (Creature& creature, sf::Time) {
+    creature.create_projectile(Projectile::PlayerFire, 0.f, 0.5f);
+});
+
 Creature::Creature(Type type, const TextureHolder& textures,
         const FontHolder& fonts) :
-    Entity(TABLE[type].hitpoints),
+    Entity(TABLE[type].hitpoints, NODE_TYPE),
     m_type(type),
-    m_sprite(textures.get(TABLE[type].texture)),
-    m_attack_command(),
+    m_sprite(textures.make_sprite(TABLE[type].texture)),
+    m_textures(&textures),
     m_attack_countdown(sf::Time::Zero),
     m_is_attacking(false),
-    m_is_marked_for_removal(false),
-    m_drop_pickup_command(),
     m_travelled_distance(0.f),
     m_direction_index(0),
-    m_health_display(nullptr)
+    m_health_display(nullptr),
+    // NaN differs from any hitpoints, the first update_texts() sets the text
+    m_displayed_hitpoints(std::numeric_limits<float>::quiet_NaN())
 {
     center_origin(m_sprite);
 
-    /// Attack category and action is initialized in default constructor for
-    /// direct access to &texture, ready for future use.
-    m_attack_command.category = Category::SceneGroundLayer;
-    // capture command & &textures -> create projectile for action
-    m_attack_command.action = [this, &textures] (SceneNode& node, sf::Time) {
-        create_projectile(node, Projectile::PlayerFire, 0.f, 0.5f, textures);
-    };
-    m_drop_pickup_command.category = Category::SceneGroundLayer;
-    m_drop_pickup_command.action = [this, &textures] (SceneNode& node, sf::Time) {
-        create_pickup(node, textures);
-    };
-
     /** @brief Smart pointer to TextNode on the heap is initialized in default
      * constructor, for health display (and other text info...).
      * @note TextNode is suspect for errors. Has exception handling, is wrapped
@@ -54,9 +64,11 @@ Creature::Creature(Type type, const TextureHolder& textures,
     try {
         std::unique_ptr<TextNode> health_display(new TextNode(fonts, ""));
         m_health_display = health_display.get(); // mem ptr that points to node
+        m_health_display->setPosition(0.f, 50.f);
         attach_child(std::move(health_display));
-        // print success to match expected text nodes with expected creatures
-        std::cout << "Text node initialized\n";
+        // uncomment to print success to match expected text nodes with
+        // expected creatures
+        //std::cout << "Text node initialized\n";
     } catch (std::exception& e) {
         std::cerr << "\nexception: " << e.what() << std::endl;
     }
@@ -66,8 +78,9 @@ Creature::Creature(Type type, const TextureHolder& textures,
         // do special things for player
     //}
 
-    // print success to match expected text updates with expected creatures
-    std::cout << "Text for creature updated\n";
+    // uncomment to print success to match expected text updates with
+    // expected creatures
+    //std::cout << "Text for creature updated\n";
     update_texts();
 }
 
@@ -104,26 +117,70 @@ void Creature::draw_current(sf::RenderTarget& target, sf::RenderStates states)
     target.draw(m_sprite, states);
 }
 
+void Creature::collect_current(SpriteBatch& batch,
+        const sf::Transform& transform) const
+{
+    batch.add(m_sprite, transform);
+}
+
+/**
+ * @return Bounds of the sprite, relative to the Creature.
+ */
+sf::FloatRect Creature::get_cull_bounds() const
+{
+    return m_sprite.getGlobalBounds();
+}
+
 /**
  * Update the current Creature.
  */
 void Creature::update_current(sf::Time dt, CommandQueue& commands)
 {
-    /** @note Checks if Creature is_destroyed() first, if is_destroyed() RNG
-     * check_pickup_drop() and is_marked_for_removal(). */
-    if (is_destroyed()) {
-        check_pickup_drop(commands);
-        m_is_marked_for_removal = true;
-    } else {
-        /** @brief check_projectile_launch() to check if attack(s) should be
-         * updated. */
-        check_projectile_launch(dt, commands);
-        /** @brief Update Creature pathing and apply velocity. */
-        update_pathing(dt);
-        Entity::update_current(dt, commands);
-        /** @brief Update Creature texts. */
-        update_texts();
-    }
+    /** @note Destroyed Creature(s) are in their death effect phase, handled by
+     * DestructionQueue - do not attack or move. */
+    if (is_destroyed())
+        return;
+    /** @brief check_projectile_launch() to check if attack(s) should be
+     * updated. */
+    check_projectile_launch(dt, commands);
+    /** @brief Update Creature pathing and apply velocity. */
+    update_pathing(dt);
+    Entity::update_current(dt, commands);
+    /** @brief Update Creature texts. */
+    update_texts();
+}
+
+/**
+ * Death effect of the Creature, publishes Events::CreatureDied (reacted to by
+ * drops and score).
+ * @see DestructionQueue::update(), World::on_creature_died().
+ * @note Published as an event rather than a command, the creature (and its
+ * handle) may be reclaimed before a command would run.
+ */
+void Creature::on_destroy(CommandQueue&)
+{
+    Context* context = get_context();
+    if (context != nullptr && context->events != nullptr)
+        context->events->publish(Events::CreatureDied{get_category(),
+                get_world_position()});
+}
+
+/**
+ * @return Returns death effect duration of Creature::Type from
+ * data_tables.cpp.
+ */
+sf::Time Creature::get_death_duration() const
+{
+    return TABLE[m_type].death_duration;
+}
+
+/**
+ * Player is never reclaimed, World keeps a pointer to the Player Creature.
+ * @return True if not Player, false if Player.
+ */
+bool Creature::is_reclaimable() const
+{
+    return m_type != Player;
 }
 
 void Creature::update_pathing(sf::Time dt)
@@ -144,31 +201,21 @@ void Creature::update_pathing(sf::Time dt)
         /* NOTE: if the distance to travel is no multiple of the creature's
         speed, the creature will move further than intended. */
         float radians = to_radian(DIRECTIONS[m_direction_index].angle);
-        std::cout << "Radians of creature: " << radians << "\n";
+        // uncomment to print the direction every tick
+        //std::cout << "Radians of creature: " << radians << "\n";
         // velocity for x = speed * cos(radians)
         float vx = get_max_speed() * std::cos(radians);
         // velocity for y = speed * sin(radians)
         float vy = get_max_speed() * std::sin(radians);
         set_velocity(vx, vy);
-        std::cout << "Velocity of creature: " << vx << "x*" << vy << "y"
-            << std::endl;
+        // uncomment to print the velocity every tick
+        //std::cout << "Velocity of creature: " << vx << "x*" << vy << "y"
+        //    << std::endl;
         // distance travelled = speed * time
         m_travelled_distance += get_max_speed() * dt.asSeconds();
     }
 }
 
-/**
- * RNG to determine if NPC should drop Pickup.
- * @see random_int() for RNG implementation.
- */
-void Creature::check_pickup_drop(CommandQueue& commands)
-{
-    /** @attention Enemy(ies) have 1/3 chance to drop Pickup. */
-    if (!is_allied() && random_int(3) == 0) {
-        commands.push(m_drop_pickup_command);
-    }
-}
-
 /**
  * Assign correct Texture to ID of Creature.
  * @note Default Texture is Textures::Player.
@@ -216,21 +263,13 @@ sf::FloatRect Creature::get_bounding_rect() const
     return get_world_transform().transformRect(m_sprite.getGlobalBounds());
 }
 
-/// Uses member variable flag to determine if marked for removal or not.
-bool Creature::is_marked_for_removal() const
-{
-    return m_is_marked_for_removal;
-}
-
 void Creature::update_texts()
 {
-    // catting str with '+'...?
-    m_health_display->set_string(std::to_string(get_hitpoints()) + " HP");
-    // print success to make sure this is only done once!
-    std::cout << "Update texts: Health display text set ... success!\n"
-        // and shows the correct string...
-        << "Text: " << std::to_string(get_hitpoints()) << " HP\n";
-    m_health_display->setPosition(0.f, 50.f);
+    // the health display is only rebuilt when the hitpoints change
+    if (get_hitpoints() != m_displayed_hitpoints) {
+        m_displayed_hitpoints = get_hitpoints();
+        m_health_display->set_string(std::to_string(get_hitpoints()) + " HP");
+    }
     // -rotation negates any rotation of creature and keeps text upright
     m_health_display->setRotation(-getRotation());
 }
@@ -247,7 +286,13 @@ void Creature::check_projectile_launch(sf::Time delta_time,
     // only proceed if is_attacking & attack countdown = 0
     if (m_is_attacking && m_attack_countdown <= sf::Time::Zero) {
         // queue attack in command queue - commands to be exec in order recieved
-        commands.push(m_attack_command);
+        // the shared prototype is addressed to this creature (unregistered
+        // creatures can not be addressed, and do not attack)
+        if (get_handle().is_valid()) {
+            Command attack_command = ATTACK_PROTOTYPE.clone();
+            attack_command.target = get_handle();
+            commands.push(std::move(attack_command));
+        }
         // attack rate + 1, to divide 1 / 1 = remainder, attack rate in seconds
         m_attack_countdown += sf::seconds(1.f / (m_attack_rate + 1.f));
         // attack has been done! no longer attacking...
@@ -261,11 +306,18 @@ void Creature::check_projectile_launch(sf::Time delta_time,
     /// @todo Different styles of attack...
 }
 
-void Creature::create_projectile(SceneNode& node, Projectile::Type type,
-        float x_offset, float y_offset, const TextureHolder& textures) const
+/**
+ * Creates a projectile at the creature, spawned into the world at the next
+ * safe point of the tick.
+ * @see Entity::spawn()
+ */
+void Creature::create_projectile(Projectile::Type type, float x_offset,
+        float y_offset)
 {
     /// Smart pointer to projectile initialized on the heap.
-    std::unique_ptr<Projectile> projectile(new Projectile(type, textures));
+    std::unique_ptr<Projectile> projectile(new Projectile(type, *m_textures));
+    /// Projectile shares the World systems of the Creature that launched it.
+    projectile->set_context(get_context());
     // to create outside sprite -> offset is (x, y) offset * sprite (x, y)
     sf::Vector2f offset(x_offset * m_sprite.getGlobalBounds().width,
             y_offset * m_sprite.getGlobalBounds().height);
@@ -281,8 +333,8 @@ void Creature::create_projectile(SceneNode& node, Projectile::Type type,
     /// Uses set_velocity(), a user-defined member fn.
     projectile->set_velocity(velocity * sign); // up or down? enemy/friendly
 
-    /// Attach the projectile as a child scene node of the scene graph.
-    node.attach_child(std::move(projectile));
+    /// Spawn the projectile, attached once to the world's entity layer.
+    spawn(std::move(projectile));
 }
 
 /**
@@ -315,18 +367,3 @@ void Creature::attack()
         m_is_attacking = true;
 }
 
-void Creature::create_pickup(SceneNode& node, const TextureHolder& textures)
-    const
-{
-    /// Get random pickup type, using random_int() and type count of pickups.
-    auto type = static_cast<Pickup::Type>(random_int(Pickup::TypeCount));
-
-    /// Create unique_ptr to pickup on the heap.
-    std::unique_ptr<Pickup> pickup(new Pickup(type, textures));
-
-    pickup->setPosition(get_world_position());
-    pickup->set_velocity(0.f, 1.f);
-
-    /// Attach pickup as child scene node on the scene graph.
-    node.attach_child(std::move(pickup));
-}
@@ -3,9 +3,6 @@
 #include "projectile.h"
 #include "pickup.h"
 
-// for std::bind() placeholders _1, _2, & so on...
-using namespace std::placeholders;
-
 std::vector<CreatureData> initialize_creature_data()
 {
     // init vector to amt of creatures (typecount enum holds creature count)
@@ -57,6 +54,10 @@ std::vector<ProjectileData> initialize_projectile_data()
     data[Projectile::PlayerFire].damage = 5.f;
     data[Projectile::PlayerFire].speed = 200.f;
     data[Projectile::PlayerFire].texture = Textures::FireProjectile;
+    /// PlayerFire is guided, acquires targets within 300.f px and
+    /// re-evaluates its target every 0.2 sec.
+    data[Projectile::PlayerFire].guide_range = 300.f;
+    data[Projectile::PlayerFire].retarget_interval = sf::seconds(0.2f);
 
     /** @brief Projectile::EnemyFire does 5.f damage, has 200.f speed, and
      * texture is Textures::FireProjectile */
@@ -73,16 +74,15 @@ std::vector<PickupData> initialize_pickup_data()
 
     data[Pickup::HealthRefill].texture = Textures::HealthRefill;
     /// HealthRefill refills 15.f HP.
-    data[Pickup::HealthRefill].action = [] (Creature& c) { c.heal(15.f); };
+    data[Pickup::HealthRefill].effect = Effect{Effects::Heal, 15.f};
 
     /// @todo Implement other pickups...
     /* data[Pickup::AttackRate].texture = Textures::AttackRate;
-    data[Pickup::AttackRate].action = std::bind(&Creature::increase_attack_rate, _1);
+    data[Pickup::AttackRate].effect = Effect{Effects::AttackRate, 1.f};
 
     data[Pickup::Arrows].texture = Textures::Arrows;
-    // binds std::placeholder::_1 to first param of Creature::collect_ammunition,
-    // and amt 3 to second param
-    data[Pickup::Arrows].action = std::bind(&Creature::collect_ammunition, _1, 3); */
+    // collect 3 arrows
+    data[Pickup::Arrows].effect = Effect{Effects::Arrows, 3.f}; */
 
     return data;
 }
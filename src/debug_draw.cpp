@@ -0,0 +1,158 @@
+#include "debug_draw.h"
+#include "draw_list.h"
+#include "text_node.h"
+
+#include <SFML/Graphics/Font.hpp>
+
+#include <cmath>
+
+namespace {
+    /// Character size of debug texts, in screen px. Lines use the same font
+    /// page.
+    constexpr unsigned int CHARACTER_SIZE = 12;
+    /// Texture coordinates of the white square at the top left of every font
+    /// page, see sf::Font.
+    const sf::Vector2f WHITE_TEXEL(1.f, 1.f);
+}
+
+/**
+ * @param const sf::Font& font
+ * Font of debug texts, must outlive the frames drawn.
+ */
+DebugDraw::DebugDraw(const sf::Font& font) :
+    m_font(font),
+    m_is_enabled(false),
+    m_pixel_size(1.f),
+    m_vertices()
+{
+}
+
+/**
+ * Enables or disables collecting, disabling drops what was collected.
+ */
+void DebugDraw::set_enabled(bool enabled)
+{
+    m_is_enabled = enabled;
+    if (!m_is_enabled)
+        clear();
+}
+
+bool DebugDraw::is_enabled() const
+{
+    return m_is_enabled;
+}
+
+void DebugDraw::toggle()
+{
+    set_enabled(!m_is_enabled);
+}
+
+/**
+ * Sets the size of one screen px in units of the view the batch is drawn in,
+ * e.g. view width / window width.
+ */
+void DebugDraw::set_pixel_size(float pixel_size)
+{
+    m_pixel_size = pixel_size;
+}
+
+/**
+ * Empties the batch for the next frame, keeping its capacity.
+ */
+void DebugDraw::clear()
+{
+    m_vertices.clear();
+}
+
+/**
+ * Adds a one px wide line from from to to.
+ */
+void DebugDraw::line(sf::Vector2f from, sf::Vector2f to, sf::Color color)
+{
+    if (!m_is_enabled)
+        return;
+    sf::Vector2f direction = to - from;
+    float length = std::sqrt(direction.x * direction.x
+            + direction.y * direction.y);
+    if (length <= 0.f)
+        return;
+    // half the width on each side of the line
+    sf::Vector2f normal(-direction.y / length * m_pixel_size / 2.f,
+            direction.x / length * m_pixel_size / 2.f);
+
+    sf::Vertex a(from + normal, color, WHITE_TEXEL);
+    sf::Vertex b(to + normal, color, WHITE_TEXEL);
+    sf::Vertex c(to - normal, color, WHITE_TEXEL);
+    sf::Vertex d(from - normal, color, WHITE_TEXEL);
+    m_vertices.push_back(a);
+    m_vertices.push_back(b);
+    m_vertices.push_back(d);
+    m_vertices.push_back(d);
+    m_vertices.push_back(b);
+    m_vertices.push_back(c);
+}
+
+/**
+ * Adds the outline of rect.
+ */
+void DebugDraw::rect(const sf::FloatRect& rect, sf::Color color)
+{
+    if (!m_is_enabled)
+        return;
+    sf::Vector2f top_left(rect.left, rect.top);
+    sf::Vector2f top_right(rect.left + rect.width, rect.top);
+    sf::Vector2f bottom_right(rect.left + rect.width, rect.top + rect.height);
+    sf::Vector2f bottom_left(rect.left, rect.top + rect.height);
+    line(top_left, top_right, color);
+    line(top_right, bottom_right, color);
+    line(bottom_right, bottom_left, color);
+    line(bottom_left, top_left, color);
+}
+
+/**
+ * Adds a diagonal cross of size (in view units) centered on center, e.g. to
+ * mark a point.
+ */
+void DebugDraw::cross(sf::Vector2f center, float size, sf::Color color)
+{
+    if (!m_is_enabled)
+        return;
+    float half = size / 2.f;
+    line(center + sf::Vector2f(-half, -half), center + sf::Vector2f(half, half),
+            color);
+    line(center + sf::Vector2f(-half, half), center + sf::Vector2f(half, -half),
+            color);
+}
+
+/**
+ * Adds text with its top left at position, CHARACTER_SIZE screen px high.
+ */
+void DebugDraw::text(sf::Vector2f position, const std::string& text,
+        sf::Color color)
+{
+    if (!m_is_enabled)
+        return;
+    std::size_t first = m_vertices.size();
+    append_glyph_quads(m_vertices, m_font, CHARACTER_SIZE, text, color);
+    for (std::size_t i = first; i < m_vertices.size(); ++i)
+        m_vertices[i].position = position
+            + m_vertices[i].position * m_pixel_size;
+}
+
+/**
+ * Records the batch into frame as one draw call, in the current view of the
+ * frame.
+ */
+void DebugDraw::draw(DrawList& frame) const
+{
+    frame.add(m_vertices.data(), m_vertices.size(),
+            &get_glyph_page(m_font, CHARACTER_SIZE));
+}
+
+/**
+ * @return Returns the count of collected vertices, six per line or glyph.
+ */
+std::size_t DebugDraw::get_vertex_count() const
+{
+    return m_vertices.size();
+}
@@ -0,0 +1,94 @@
+#include "destruction_queue.h"
+#include "entity.h"
+#include "command_queue.h"
+
+#include <algorithm>
+#include <cassert>
+
+/**
+ * Push a destroyed entity into the pending death list.
+ * @note Called by Entity, once per destruction.
+ */
+void DestructionQueue::push(Entity& entity)
+{
+    m_pending.push_back(PendingDeath{&entity, sf::Time::Zero, false});
+}
+
+/**
+ * Run the death effect phase of every pending entity, then reclaim the ones
+ * whose death effect is over in one batch.
+ * @remark Indexed loop, on_destroy() may destroy (and push) other entities,
+ * so no reference into m_pending is held across it.
+ */
+void DestructionQueue::update(sf::Time delta_time, CommandQueue& commands)
+{
+    for (std::size_t i = 0; i < m_pending.size(); ++i) {
+        /// Death effect starts on the first update after destruction.
+        if (!m_pending[i].is_started) {
+            m_pending[i].is_started = true;
+            m_pending[i].countdown = m_pending[i].entity->get_death_duration();
+            m_pending[i].entity->on_destroy(commands);
+        }
+        // taken after on_destroy(), pushes may have reallocated m_pending
+        PendingDeath& death = m_pending[i];
+        /// Death effect is over, entity can be reclaimed.
+        if (death.countdown <= sf::Time::Zero) {
+            if (death.entity->is_reclaimable()) {
+                // commands addressed to the entity are dropped from now on
+                death.entity->release_handle();
+                m_expired.push_back(death.entity);
+            }
+            death.entity = nullptr;
+        } else {
+            death.countdown -= delta_time;
+        }
+    }
+    /// Erase expired deaths (entity set to nullptr above).
+    m_pending.erase(std::remove_if(m_pending.begin(), m_pending.end(),
+                [] (const PendingDeath& death) {
+                    return death.entity == nullptr;
+                }), m_pending.end());
+
+    if (!m_expired.empty())
+        reclaim();
+}
+
+/**
+ * @return Returns the count of entities in their death effect phase.
+ */
+std::size_t DestructionQueue::get_pending_count() const
+{
+    return m_pending.size();
+}
+
+/**
+ * Detach all expired entities from the scene graph, one pass per parent, and
+ * free them together.
+ */
+void DestructionQueue::reclaim()
+{
+    /// Group expired entities by parent, so each parent's children are only
+    /// swept once.
+    std::sort(m_expired.begin(), m_expired.end(),
+            [] (const SceneNode* lhs, const SceneNode* rhs) {
+                return lhs->get_parent() < rhs->get_parent();
+            });
+
+    auto group_begin = m_expired.begin();
+    while (group_begin != m_expired.end()) {
+        SceneNode* parent = (*group_begin)->get_parent();
+        auto group_end = std::find_if(group_begin, m_expired.end(),
+                [parent] (const SceneNode* node) {
+                    return node->get_parent() != parent;
+                });
+        // entities are always attached to the scene graph when destroyed
+        assert(parent != nullptr);
+        parent->detach_children(group_begin, group_end, m_reclaimed);
+        group_begin = group_end;
+    }
+    m_expired.clear();
+
+    /// Nodes (and their children) are freed here, after every group has been
+    /// detached - keeps capacity for the next batch.
+    m_reclaimed.clear();
+}
@@ -0,0 +1,204 @@
+#include "draw_list.h"
+#include "text_node.h"
+
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Text.hpp>
+
+#include <utility>
+
+DrawList::DrawList() :
+    m_items(),
+    m_views(),
+    m_vertices(),
+    m_sprites(),
+    m_shapes(),
+    m_callbacks(),
+    m_synchronous(false),
+    m_interpolation(1.f),
+    m_sequence(0),
+    m_drawn_sequence(0)
+{
+}
+
+/**
+ * Empties the list for the next frame, keeping its capacity.
+ * @note The sequence numbers are kept, they are set by the owner of the frame
+ * (see set_sequence()).
+ */
+void DrawList::clear()
+{
+    m_items.clear();
+    m_views.clear();
+    m_vertices.clear();
+    m_sprites.clear();
+    m_shapes.clear();
+    m_callbacks.clear();
+    m_synchronous = false;
+    m_interpolation = 1.f;
+}
+
+/**
+ * Sets the view of the items added after it.
+ */
+void DrawList::set_view(const sf::View& view)
+{
+    m_items.push_back(Item{Kind::View, m_views.size(), 1, nullptr, nullptr,
+            sf::Transform::Identity});
+    m_views.push_back(view);
+}
+
+/**
+ * Adds a copy of count vertices, drawn as triangles with texture.
+ */
+void DrawList::add(const sf::Vertex* vertices, std::size_t count,
+        const sf::Texture* texture)
+{
+    if (count == 0)
+        return;
+    m_items.push_back(Item{Kind::Vertices, m_vertices.size(), count, texture,
+            nullptr, sf::Transform::Identity});
+    m_vertices.insert(m_vertices.end(), vertices, vertices + count);
+}
+
+void DrawList::add(const sf::Sprite& sprite, const sf::Transform& transform)
+{
+    m_items.push_back(Item{Kind::Sprite, m_sprites.size(), 1, nullptr, nullptr,
+            transform});
+    m_sprites.push_back(sprite);
+}
+
+/**
+ * Adds text as glyph quads, laid out now on the recording thread and drawn
+ * with the font page of its character size.
+ * @note Only the font, character size, string, fill color and transform of
+ * text are recorded, styles and outlines are not.
+ */
+void DrawList::add(const sf::Text& text, const sf::Transform& transform)
+{
+    const sf::Font* font = text.getFont();
+    if (font == nullptr)
+        return;
+    const sf::Texture& page = get_glyph_page(*font, text.getCharacterSize());
+    std::size_t first = m_vertices.size();
+    append_glyph_quads(m_vertices, *font, text.getCharacterSize(),
+            text.getString().toAnsiString(), text.getFillColor());
+    if (m_vertices.size() == first)
+        return;
+    m_items.push_back(Item{Kind::Vertices, first, m_vertices.size() - first,
+            &page, nullptr, transform * text.getTransform()});
+}
+
+void DrawList::add(const sf::RectangleShape& shape)
+{
+    m_items.push_back(Item{Kind::Shape, m_shapes.size(), 1, nullptr, nullptr,
+            sf::Transform::Identity});
+    m_shapes.push_back(shape);
+}
+
+/**
+ * Adds a drawable by reference, for GPU resources that are not copied (e.g.
+ * sf::VertexBuffer).
+ * @attention drawable must not change until the frame is drawn.
+ */
+void DrawList::add(const sf::Drawable& drawable, const sf::Transform& transform,
+        const sf::Texture* texture)
+{
+    m_items.push_back(Item{Kind::Drawable, 0, 1, texture, &drawable,
+            transform});
+}
+
+/**
+ * Adds custom drawing, run on the render thread in draw order.
+ * @note Callbacks touching state of the simulation thread (e.g. ImGui) also
+ * need set_synchronous().
+ */
+void DrawList::add(Callback callback)
+{
+    m_items.push_back(Item{Kind::Callback, m_callbacks.size(), 1, nullptr,
+            nullptr, sf::Transform::Identity});
+    m_callbacks.push_back(std::move(callback));
+}
+
+/**
+ * Marks the frame to be drawn before the simulation goes on, see
+ * RenderThread::publish().
+ */
+void DrawList::set_synchronous()
+{
+    m_synchronous = true;
+}
+
+bool DrawList::is_synchronous() const
+{
+    return m_synchronous;
+}
+
+/**
+ * Sets the fraction of a tick elapsed since the last update, in [0, 1], for
+ * recorders to interpolate moving objects by.
+ */
+void DrawList::set_interpolation(float interpolation)
+{
+    m_interpolation = interpolation;
+}
+
+float DrawList::get_interpolation() const
+{
+    return m_interpolation;
+}
+
+/**
+ * Sets the number of this frame, and of the last frame fully drawn when this
+ * one was begun. Resources used by frames up to drawn_sequence are no longer
+ * in use by the renderer (e.g. retired LayerCache tiles).
+ * @note Frames are numbered from 1, frames skipped by the renderer count as
+ * drawn once a later frame is.
+ */
+void DrawList::set_sequence(std::uint64_t sequence,
+        std::uint64_t drawn_sequence)
+{
+    m_sequence = sequence;
+    m_drawn_sequence = drawn_sequence;
+}
+
+std::uint64_t DrawList::get_sequence() const
+{
+    return m_sequence;
+}
+
+std::uint64_t DrawList::get_drawn_sequence() const
+{
+    return m_drawn_sequence;
+}
+
+/**
+ * Draws all items in order, called by the render thread.
+ */
+void DrawList::draw(sf::RenderTarget& target) const
+{
+    for (const Item& item : m_items) {
+        sf::RenderStates states(item.transform);
+        states.texture = item.texture;
+        switch (item.kind) {
+        case Kind::View:
+            target.setView(m_views[item.index]);
+            break;
+        case Kind::Vertices:
+            target.draw(&m_vertices[item.index], item.count, sf::Triangles,
+                    states);
+            break;
+        case Kind::Sprite:
+            target.draw(m_sprites[item.index], states);
+            break;
+        case Kind::Shape:
+            target.draw(m_shapes[item.index], states);
+            break;
+        case Kind::Drawable:
+            target.draw(*item.drawable, states);
+            break;
+        case Kind::Callback:
+            m_callbacks[item.index](target);
+            break;
+        }
+    }
+}
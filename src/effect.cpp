@@ -0,0 +1,43 @@
+#include "effect.h"
+#include "creature.h"
+
+#include <cassert>
+
+/**
+ * Buffer an effect to be applied to target on the next apply().
+ * @note Effects with no kind are dropped.
+ */
+void EffectBuffer::push(Creature& target, Effect effect)
+{
+    if (effect.kind == Effects::None)
+        return;
+    m_pending.push_back(PendingEffect{&target, effect});
+}
+
+/**
+ * Resolve all buffered effects in one pass, then clear the buffer.
+ * @remark Switch on Effects::Kind instead of a type-erased call per effect.
+ * Buffer keeps its capacity between ticks.
+ */
+void EffectBuffer::apply()
+{
+    for (const PendingEffect& pending : m_pending) {
+        switch (pending.effect.kind) {
+        case Effects::Heal:
+            pending.target->heal(pending.effect.magnitude);
+            break;
+        case Effects::None:
+        case Effects::KindCount:
+            // guarded in push(), should never be buffered
+            assert(false);
+            break;
+        }
+    }
+    m_pending.clear();
+}
+
+/// Check if effect buffer is empty - t/f
+bool EffectBuffer::is_empty() const
+{
+    return m_pending.empty();
+}
@@ -1,6 +1,15 @@
 //#define SFML_STATIC
 
 #include "entity.h"
+#include "destruction_queue.h"
+#include "entity_registry.h"
+#include "spawn_queue.h"
+#include "debug_draw.h"
+
+namespace {
+    /// Time ahead shown by the debug path of moving entities.
+    constexpr float DEBUG_PATH_SECONDS = 0.5f;
+}
 
 void Entity::heal(float hitpoints)
 {
@@ -14,14 +23,21 @@ void Entity::damage(float hitpoints)
 {
     /// Make sure hitpoints are greater than zero.
     assert(hitpoints > 0);
+    /// Only the hit that destroys the entity enqueues it, not overkill.
+    bool was_destroyed = is_destroyed();
     /// Subtract damage from hitpoints.
     m_hitpoints -= hitpoints;
+    if (!was_destroyed && is_destroyed())
+        enqueue_destruction();
 }
 
-/// Sets hitpoints to zero.
+/// Sets hitpoints to zero and enqueues the entity's destruction.
 void Entity::destroy()
 {
+    if (is_destroyed())
+        return;
     m_hitpoints = 0;
+    enqueue_destruction();
 }
 
 /**
@@ -42,6 +58,95 @@ bool Entity::is_destroyed() const
     return m_hitpoints <= 0;
 }
 
+/**
+ * Set the World systems shared by all entities, and register the entity in
+ * the registry of the context to give it a handle.
+ * @note Entities without a context are never reclaimed.
+ */
+void Entity::set_context(Context* context)
+{
+    release_handle();
+    m_context = context;
+    if (m_context != nullptr && m_context->registry != nullptr)
+        m_handle = m_context->registry->add(*this);
+}
+
+/**
+ * @return Returns the World systems shared by all entities, to pass on to
+ * entities created by this entity.
+ */
+Entity::Context* Entity::get_context() const
+{
+    return m_context;
+}
+
+/**
+ * Hands a created entity (projectile, pickup...) to the spawn queue of the
+ * context, to be inserted into the world once, at the next safe point.
+ * @note Entities without a context can not spawn, entity is freed.
+ */
+void Entity::spawn(Ptr entity)
+{
+    if (m_context != nullptr && m_context->spawns != nullptr)
+        m_context->spawns->push(std::move(entity));
+}
+
+/**
+ * @return Returns the handle to address commands to this entity, invalid if
+ * the entity is not registered.
+ */
+EntityHandle Entity::get_handle() const
+{
+    return m_handle;
+}
+
+/**
+ * Unregister the entity, handles to it no longer resolve.
+ * @note Called by DestructionQueue before the entity is reclaimed.
+ */
+void Entity::release_handle()
+{
+    if (m_handle.is_valid()) {
+        m_context->registry->remove(m_handle);
+        m_handle = EntityHandle();
+    }
+}
+
+/**
+ * Death effect, ran once by DestructionQueue when the entity's destruction is
+ * processed.
+ * @note Does nothing by default, overwrite in derived class(es).
+ */
+void Entity::on_destroy(CommandQueue&)
+{
+}
+
+/**
+ * @return Returns how long the entity stays in the scene graph after
+ * destruction, for its death effect.
+ * @note Default is sf::Time::Zero, reclaimed the tick it is destroyed.
+ */
+sf::Time Entity::get_death_duration() const
+{
+    return sf::Time::Zero;
+}
+
+/**
+ * @return Returns true if the entity is detached and freed after its death
+ * effect, false if it stays in the scene graph.
+ */
+bool Entity::is_reclaimable() const
+{
+    return true;
+}
+
+/// Push the entity into the pending death list of its context.
+void Entity::enqueue_destruction()
+{
+    if (m_context != nullptr && m_context->destructions != nullptr)
+        m_context->destructions->push(*this);
+}
+
 void Entity::set_velocity(sf::Vector2f velocity)
 {
     m_velocity = velocity;
@@ -80,3 +185,17 @@ void Entity::update_current(sf::Time delta_time, CommandQueue& commands)
     /// Move entity based on velocity and delta time elapsed.
     move(m_velocity * delta_time.asSeconds());
 }
+
+/**
+ * Shows the path of a moving entity, where its velocity takes it in
+ * DEBUG_PATH_SECONDS.
+ */
+void Entity::debug_draw_current(DebugDraw& debug,
+        const sf::Transform& transform) const
+{
+    if (m_velocity == sf::Vector2f())
+        return;
+    sf::Vector2f position = transform.transformPoint(0.f, 0.f);
+    debug.line(position, position + m_velocity * DEBUG_PATH_SECONDS,
+            sf::Color::Cyan);
+}
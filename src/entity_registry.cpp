@@ -0,0 +1,56 @@
+#include "entity_registry.h"
+
+#include <cassert>
+
+/**
+ * Registers entity in a free slot.
+ * @return Returns the handle that addresses entity until it is removed.
+ */
+EntityHandle EntityRegistry::add(Entity& entity)
+{
+    std::uint32_t index;
+    if (!m_free.empty()) {
+        index = m_free.back();
+        m_free.pop_back();
+    } else {
+        index = static_cast<std::uint32_t>(m_slots.size());
+        // generation 0 is reserved for invalid handles
+        m_slots.push_back(Slot{nullptr, 1});
+    }
+    Slot& slot = m_slots[index];
+    slot.entity = &entity;
+    return EntityHandle(index, slot.generation);
+}
+
+/**
+ * Unregisters the entity addressed by handle, invalidating all its handles.
+ */
+void EntityRegistry::remove(EntityHandle handle)
+{
+    assert(get(handle) != nullptr);
+    Slot& slot = m_slots[handle.index];
+    slot.entity = nullptr;
+    // skip generation 0 on wrap around
+    if (++slot.generation == 0)
+        slot.generation = 1;
+    m_free.push_back(handle.index);
+}
+
+/**
+ * @return Returns the entity addressed by handle, nullptr if it was removed.
+ */
+Entity* EntityRegistry::get(EntityHandle handle) const
+{
+    if (handle.index >= m_slots.size())
+        return nullptr;
+    const Slot& slot = m_slots[handle.index];
+    return slot.generation == handle.generation ? slot.entity : nullptr;
+}
+
+/**
+ * @return Returns the count of registered entities.
+ */
+std::size_t EntityRegistry::size() const
+{
+    return m_slots.size() - m_free.size();
+}
@@ -0,0 +1,265 @@
+#include "horde.h"
+#include "world.h"
+#include "conf.h"
+#include "r_holders.h"
+#include "offscreen_renderer.h"
+#include "utility.h"
+
+#include <SFML/Graphics/RenderWindow.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace {
+    /// Count of cluster centers per wave, for HordeConfig::Cluster.
+    constexpr std::size_t CLUSTER_COUNT = 4;
+
+    /// Converts a creature name (as printed by operator<<) to Creature::Type.
+    Creature::Type to_creature_type(std::string_view name)
+    {
+        if (name == "bunny")
+            return Creature::Bunny;
+        if (name == "bear")
+            return Creature::Bear;
+        throw std::runtime_error("parse_horde_config - Unknown creature "
+                + std::string(name));
+    }
+
+    /// Returns value of "--key=value" if arg starts with "--key=".
+    bool match_option(std::string_view arg, std::string_view key,
+            std::string_view& value)
+    {
+        if (arg.size() <= key.size() + 3 || arg.substr(0, 2) != "--"
+                || arg.substr(2, key.size()) != key
+                || arg[key.size() + 2] != '=')
+            return false;
+        value = arg.substr(key.size() + 3);
+        return true;
+    }
+}
+
+/**
+ * Default constructor starts at level 0, and seeds the horde's own random
+ * engine so that a load shape is repeatable.
+ */
+Horde::Horde(const HordeConfig& config) :
+    m_config(config),
+    m_random_engine(config.seed),
+    m_group_distribution(),
+    m_cluster_centers(),
+    m_level(0),
+    m_level_time(sf::Time::Zero),
+    m_projectile_budget(0.f),
+    m_is_wave_spawned(false),
+    m_is_level_over(false)
+{
+    std::vector<float> weights;
+    for (const HordeConfig::Group& group : m_config.groups)
+        weights.push_back(group.weight);
+    // horde needs at least one group to pick creatures from
+    if (weights.empty())
+        throw std::runtime_error("Horde - No creature groups");
+    m_group_distribution = std::discrete_distribution<std::size_t>(
+            weights.begin(), weights.end());
+}
+
+/**
+ * Advance the horde by delta time.
+ * @param sf::Vector2f center
+ * Center the horde is placed around, e.g. the player position.
+ * @param std::vector<SpawnPoint>& creatures
+ * Creatures to spawn this tick, appended to.
+ * @param std::vector<sf::Vector2f>& projectiles
+ * Positions to fire projectiles from (at center) this tick, appended to.
+ * @note A level's wave is spawned on its first tick. Level count of creatures
+ * is initial_count * growth^level.
+ */
+void Horde::update(sf::Time delta_time, sf::Vector2f center,
+        std::vector<SpawnPoint>& creatures,
+        std::vector<sf::Vector2f>& projectiles)
+{
+    m_is_level_over = false;
+    if (is_finished())
+        return;
+
+    if (!m_is_wave_spawned) {
+        spawn_wave(center, creatures);
+        m_is_wave_spawned = true;
+    }
+
+    /// Projectile budget accumulates fractional projectiles between ticks.
+    m_projectile_budget += m_config.projectile_rate * delta_time.asSeconds();
+    for (; m_projectile_budget >= 1.f; m_projectile_budget -= 1.f)
+        projectiles.push_back(on_ring(center));
+
+    m_level_time += delta_time;
+    if (m_level_time >= m_config.level_duration) {
+        m_is_level_over = true;
+        m_level_time = sf::Time::Zero;
+        m_is_wave_spawned = false;
+        ++m_level;
+    }
+}
+
+/**
+ * @return Returns true on the tick a level ended, to report the level.
+ */
+bool Horde::is_level_over() const
+{
+    return m_is_level_over;
+}
+
+/// Check if all levels are over - t/f
+bool Horde::is_finished() const
+{
+    return m_level >= m_config.level_count;
+}
+
+/**
+ * @return Returns current level, or the level that just ended if
+ * is_level_over().
+ */
+std::size_t Horde::get_level() const
+{
+    return m_is_level_over ? m_level - 1 : m_level;
+}
+
+void Horde::spawn_wave(sf::Vector2f center, std::vector<SpawnPoint>& creatures)
+{
+    auto count = static_cast<std::size_t>(std::round(
+                static_cast<float>(m_config.initial_count)
+                * std::pow(m_config.growth, static_cast<float>(m_level))));
+
+    /// Clusters move every wave.
+    if (m_config.distribution == HordeConfig::Cluster) {
+        m_cluster_centers.clear();
+        for (std::size_t i = 0; i < CLUSTER_COUNT; ++i)
+            m_cluster_centers.push_back(on_ring(center));
+    }
+
+    for (std::size_t i = 0; i < count; ++i) {
+        Creature::Type type =
+            m_config.groups[m_group_distribution(m_random_engine)].type;
+        creatures.push_back(SpawnPoint(type, random_position(center)));
+    }
+}
+
+/// Random position around center, respecting the configured distribution.
+sf::Vector2f Horde::random_position(sf::Vector2f center)
+{
+    switch (m_config.distribution) {
+    case HordeConfig::Uniform: {
+        std::uniform_real_distribution<float> offset(-m_config.radius,
+                m_config.radius);
+        return center + sf::Vector2f(offset(m_random_engine),
+                offset(m_random_engine));
+    }
+    case HordeConfig::Cluster: {
+        std::uniform_int_distribution<std::size_t> pick(0,
+                m_cluster_centers.size() - 1);
+        // clusters spread over a tenth of the radius
+        std::normal_distribution<float> offset(0.f, m_config.radius * 0.1f);
+        return m_cluster_centers[pick(m_random_engine)]
+            + sf::Vector2f(offset(m_random_engine), offset(m_random_engine));
+    }
+    case HordeConfig::Ring:
+    default:
+        return on_ring(center);
+    }
+}
+
+/// Random position on the circle of radius around center.
+sf::Vector2f Horde::on_ring(sf::Vector2f center)
+{
+    std::uniform_real_distribution<float> angle(0.f,
+            2.f * std::numbers::pi_v<float>);
+    float radians = angle(m_random_engine);
+    return center + m_config.radius
+        * sf::Vector2f(std::cos(radians), std::sin(radians));
+}
+
+/**
+ * Parse horde options from the command line, options not given keep their
+ * default.
+ * @note Options: --mix=bunny:3,bear:1 --distribution=uniform|ring|cluster
+ * --radius=R --initial=N --growth=X --levels=N --level-seconds=S
+ * --projectile-rate=R --seed=N
+ * @throw std::runtime_error if a creature of --mix or the --distribution is
+ * unknown.
+ */
+HordeConfig parse_horde_config(int argc, char* argv[])
+{
+    HordeConfig config;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg(argv[i]);
+        std::string_view value;
+        if (match_option(arg, "mix", value)) {
+            config.groups.clear();
+            // comma separated name:weight pairs
+            while (!value.empty()) {
+                std::string_view pair = value.substr(0, value.find(','));
+                value.remove_prefix(std::min(value.size(), pair.size() + 1));
+                std::size_t colon = pair.find(':');
+                float weight = colon == std::string_view::npos ? 1.f
+                    : std::stof(std::string(pair.substr(colon + 1)));
+                config.groups.push_back(HordeConfig::Group{
+                        to_creature_type(pair.substr(0, colon)), weight});
+            }
+        } else if (match_option(arg, "distribution", value)) {
+            if (value == "uniform")
+                config.distribution = HordeConfig::Uniform;
+            else if (value == "cluster")
+                config.distribution = HordeConfig::Cluster;
+            else if (value == "ring")
+                config.distribution = HordeConfig::Ring;
+            else
+                throw std::runtime_error("parse_horde_config - Unknown "
+                        "distribution " + std::string(value));
+        } else if (match_option(arg, "radius", value)) {
+            config.radius = std::stof(std::string(value));
+        } else if (match_option(arg, "initial", value)) {
+            config.initial_count = std::stoul(std::string(value));
+        } else if (match_option(arg, "growth", value)) {
+            config.growth = std::stof(std::string(value));
+        } else if (match_option(arg, "levels", value)) {
+            config.level_count = std::stoul(std::string(value));
+        } else if (match_option(arg, "level-seconds", value)) {
+            config.level_duration = sf::seconds(std::stof(std::string(value)));
+        } else if (match_option(arg, "projectile-rate", value)) {
+            config.projectile_rate = std::stof(std::string(value));
+        } else if (match_option(arg, "seed", value)) {
+            config.seed = static_cast<unsigned int>(
+                    std::stoul(std::string(value)));
+        }
+    }
+    return config;
+}
+
+/**
+ * Drive a World with a horde, at fixed timestep and as fast as possible, until
+ * all levels are over. World reports each level's tick cost.
+ * @note The window is never opened, World only uses it in World::draw().
+ * @param OffscreenRenderer* renderer
+ * Renders a frame after every tick if not nullptr.
+ * @note The game's random engine (e.g. pickup drops) is seeded by the horde
+ * seed too, so the same config simulates and renders the same frames.
+ */
+void run_horde(const HordeConfig& config, OffscreenRenderer* renderer)
+{
+    seed_random_engine(config.seed);
+    FontHolder fonts;
+    fonts.load(Fonts::Main, "fonts/Hack-Regular.ttf");
+    sf::RenderWindow window;
+
+    World world(window, fonts);
+    world.start_horde(config);
+    while (!world.is_horde_finished()) {
+        world.update(conf::TIME_PER_FRAME);
+        if (renderer != nullptr)
+            renderer->render(world);
+    }
+}
@@ -0,0 +1,182 @@
+#include "input_log.h"
+#include "world.h"
+#include "player.h"
+#include "r_holders.h"
+#include "utility.h"
+#include "conf.h"
+#include "offscreen_renderer.h"
+
+#include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/System/Clock.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+/// Anonymous namespace for the log header.
+namespace {
+    constexpr char MAGIC[4] = {'U', 'G', 'I', 'L'};
+    constexpr std::uint32_t VERSION = 2;
+    /// Logs of version 1 have no tick duration, and were recorded at 60 Hz.
+    constexpr std::uint32_t VERSION_FIXED_TICK = 1;
+}
+
+/**
+ * Opens filename and writes the log header.
+ * @param std::uint64_t seed
+ * RNG seed of the recorded session.
+ * @param sf::Time time_per_tick
+ * Simulation step of the recorded session, replays use the same.
+ * @throw std::runtime_error if filename can not be opened.
+ */
+InputRecorder::InputRecorder(const std::string& filename, std::uint64_t seed,
+        sf::Time time_per_tick) :
+    m_file(filename, std::ios::binary | std::ios::trunc),
+    m_tick(0),
+    m_actions(0),
+    m_record_count(0)
+{
+    if (!m_file)
+        throw std::runtime_error("InputRecorder - Failed to open " + filename);
+    m_file.write(MAGIC, sizeof(MAGIC));
+    m_file.write(reinterpret_cast<const char*>(&VERSION), sizeof(VERSION));
+    m_file.write(reinterpret_cast<const char*>(&seed), sizeof(seed));
+    std::int64_t tick_microseconds = time_per_tick.asMicroseconds();
+    m_file.write(reinterpret_cast<const char*>(&tick_microseconds),
+            sizeof(tick_microseconds));
+}
+
+InputRecorder::~InputRecorder()
+{
+    close();
+}
+
+/**
+ * Starts recording the actions executed in tick, writing the actions of the
+ * previous tick.
+ */
+void InputRecorder::begin_tick(std::uint32_t tick)
+{
+    if (tick != m_tick) {
+        flush_tick();
+        m_tick = tick;
+    }
+}
+
+/**
+ * Records action, a Player::Action, for the current tick.
+ * @note Actions are a bitmask, an action triggered more than once in a tick
+ * is recorded once.
+ */
+void InputRecorder::record(unsigned int action)
+{
+    m_actions |= action;
+}
+
+/// Writes the last tick and closes the log, further input is not recorded.
+void InputRecorder::close()
+{
+    if (!m_file.is_open())
+        return;
+    flush_tick();
+    m_file.close();
+    std::cout << "Input log closed, " << m_record_count << " tick(s) recorded\n";
+}
+
+std::size_t InputRecorder::get_record_count() const
+{
+    return m_record_count;
+}
+
+/// Ticks without input are not written.
+void InputRecorder::flush_tick()
+{
+    if (m_actions == 0 || !m_file.is_open())
+        return;
+    InputRecord record{m_tick, m_actions};
+    m_file.write(reinterpret_cast<const char*>(&record), sizeof(record));
+    m_actions = 0;
+    ++m_record_count;
+}
+
+/**
+ * Reads an input log written by InputRecorder.
+ * @throw std::runtime_error if filename can not be read or is not an input log.
+ */
+InputLog load_input_log(const std::string& filename)
+{
+    std::ifstream file(filename, std::ios::binary);
+    if (!file)
+        throw std::runtime_error("load_input_log - Failed to open " + filename);
+
+    char magic[sizeof(MAGIC)];
+    std::uint32_t version = 0;
+    InputLog log{0, conf::TIME_PER_FRAME, {}};
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(&version), sizeof(version));
+    file.read(reinterpret_cast<char*>(&log.seed), sizeof(log.seed));
+    if (!file || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0
+            || (version != VERSION && version != VERSION_FIXED_TICK))
+        throw std::runtime_error("load_input_log - Not an input log: "
+                + filename);
+    if (version == VERSION) {
+        std::int64_t tick_microseconds = 0;
+        file.read(reinterpret_cast<char*>(&tick_microseconds),
+                sizeof(tick_microseconds));
+        if (!file || tick_microseconds <= 0)
+            throw std::runtime_error("load_input_log - Bad tick duration: "
+                    + filename);
+        log.time_per_tick = sf::microseconds(tick_microseconds);
+    }
+
+    InputRecord record;
+    while (file.read(reinterpret_cast<char*>(&record), sizeof(record)))
+        log.records.push_back(record);
+    return log;
+}
+
+/**
+ * Replays an input log headless, at maximum speed: the RNG is seeded with the
+ * recorded seed and the recorded actions are fed to World on their tick,
+ * which makes the session (and its workload) repeatable.
+ * @note Ticks are replayed with the recorded simulation step.
+ * @note Prints the replayed ticks and the time per tick to std::clog.
+ * @param OffscreenRenderer* renderer
+ * Renders a frame after every tick if not nullptr, the time per tick then
+ * includes rendering.
+ */
+void run_replay(const std::string& filename, OffscreenRenderer* renderer)
+{
+    InputLog log = load_input_log(filename);
+    seed_random_engine(log.seed);
+
+    FontHolder fonts;
+    fonts.load(Fonts::Main, "fonts/Hack-Regular.ttf");
+    sf::RenderWindow window;
+    Player player;
+
+    World world(window, fonts);
+    player.set_target(world.get_player_handle());
+    CommandQueue& commands = world.get_command_queue();
+    auto tick = [&] {
+        world.update(log.time_per_tick);
+        if (renderer != nullptr)
+            renderer->render(world);
+    };
+    sf::Clock clock;
+    for (const InputRecord& record : log.records) {
+        // records are in tick order, ticks without input are skipped
+        while (world.get_tick() < record.tick)
+            tick();
+        player.replay_actions(record.actions, commands);
+    }
+    // execute the commands of the last record
+    tick();
+    sf::Time elapsed = clock.getElapsedTime();
+
+    std::clog << "Replayed " << world.get_tick() << " ticks in "
+        << elapsed.asMilliseconds() << " ms ("
+        << elapsed.asMicroseconds() / std::max<std::int64_t>(world.get_tick(), 1)
+        << " us/tick)" << std::endl;
+}
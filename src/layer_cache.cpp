@@ -0,0 +1,184 @@
+#include "layer_cache.h"
+#include "draw_list.h"
+#include "scene_node.h"
+
+#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/Graphics/View.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    /// Size of a cached tile, in px of the layer.
+    constexpr unsigned int CACHE_TILE_SIZE = 512;
+    /// Tiles kept cached, about four views of 1080p.
+    constexpr std::size_t MAX_TILES = 32;
+}
+
+/**
+ * @param const sf::FloatRect& bounds
+ * Area of the layer that is cached, nothing outside is drawn.
+ */
+LayerCache::LayerCache(const sf::FloatRect& bounds) :
+    m_bounds(bounds),
+    m_tiles(),
+    m_retired(),
+    m_frame(0),
+    m_drawn_frame(0),
+    m_is_failed(false)
+{
+}
+
+/**
+ * Adds the tiles of layer in view_bounds to frame, rendering the tiles not
+ * cached yet.
+ * @return Returns false if render textures are not available, the layer must
+ * then be drawn uncached. Nothing is added to frame then, and every later call
+ * returns false at once, instead of trying to create a texture every frame.
+ */
+bool LayerCache::collect(const SceneNode& layer, DrawList& frame,
+        const sf::FloatRect& view_bounds)
+{
+    if (m_is_failed)
+        return false;
+    m_frame = frame.get_sequence();
+    m_drawn_frame = frame.get_drawn_sequence();
+    sf::FloatRect area;
+    if (!m_bounds.intersects(view_bounds, area))
+        return true;
+
+    const float tile_size = static_cast<float>(CACHE_TILE_SIZE);
+    int left = static_cast<int>((area.left - m_bounds.left) / tile_size);
+    int top = static_cast<int>((area.top - m_bounds.top) / tile_size);
+    int right = static_cast<int>(std::ceil(
+                (area.left + area.width - m_bounds.left) / tile_size));
+    int bottom = static_cast<int>(std::ceil(
+                (area.top + area.height - m_bounds.top) / tile_size));
+
+    // render the missing tiles before adding any, so that a failure leaves
+    // frame to the uncached path alone
+    for (int y = top; y < bottom; ++y) {
+        for (int x = left; x < right; ++x) {
+            Key key(x, y);
+            if (m_tiles.find(key) != m_tiles.end())
+                continue;
+            std::unique_ptr<sf::RenderTexture> texture = acquire_texture();
+            if (!render_tile(layer, key, *texture)) {
+                m_is_failed = true;
+                return false;
+            }
+            m_tiles.emplace(key, Tile{std::move(texture), m_frame});
+        }
+    }
+
+    for (int y = top; y < bottom; ++y) {
+        for (int x = left; x < right; ++x) {
+            Tile& tile = m_tiles.at(Key(x, y));
+            tile.last_frame = m_frame;
+
+            sf::Sprite sprite(tile.texture->getTexture());
+            sprite.setPosition(m_bounds.left + x * tile_size,
+                    m_bounds.top + y * tile_size);
+            frame.add(sprite);
+        }
+    }
+    evict();
+    return true;
+}
+
+/**
+ * Drops all tiles, to be rendered again when drawn.
+ */
+void LayerCache::invalidate()
+{
+    for (auto& [key, tile] : m_tiles)
+        retire(std::move(tile.texture));
+    m_tiles.clear();
+}
+
+/**
+ * Drops the tiles intersecting area, e.g. around a changed tile of a TileMap.
+ */
+void LayerCache::invalidate(const sf::FloatRect& area)
+{
+    const float tile_size = static_cast<float>(CACHE_TILE_SIZE);
+    for (auto it = m_tiles.begin(); it != m_tiles.end();) {
+        sf::FloatRect tile_bounds(m_bounds.left + it->first.first * tile_size,
+                m_bounds.top + it->first.second * tile_size, tile_size,
+                tile_size);
+        if (tile_bounds.intersects(area)) {
+            retire(std::move(it->second.texture));
+            it = m_tiles.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+/**
+ * @return Returns the count of cached tiles.
+ */
+std::size_t LayerCache::get_tile_count() const
+{
+    return m_tiles.size();
+}
+
+/// Reuses a retired texture no longer in flight, or makes a new one.
+std::unique_ptr<sf::RenderTexture> LayerCache::acquire_texture()
+{
+    for (auto it = m_retired.begin(); it != m_retired.end(); ++it) {
+        if (it->frame <= m_drawn_frame) {
+            std::unique_ptr<sf::RenderTexture> texture =
+                std::move(it->texture);
+            m_retired.erase(it);
+            return texture;
+        }
+    }
+    return std::make_unique<sf::RenderTexture>();
+}
+
+/**
+ * Renders the area of layer under the tile at key into texture.
+ * @return Returns false if texture can not be created.
+ */
+bool LayerCache::render_tile(const SceneNode& layer, const Key& key,
+        sf::RenderTexture& texture) const
+{
+    if (texture.getSize() != sf::Vector2u(CACHE_TILE_SIZE, CACHE_TILE_SIZE)
+            && !texture.create(CACHE_TILE_SIZE, CACHE_TILE_SIZE))
+        return false;
+
+    const float tile_size = static_cast<float>(CACHE_TILE_SIZE);
+    texture.setView(sf::View(sf::FloatRect(
+                    m_bounds.left + key.first * tile_size,
+                    m_bounds.top + key.second * tile_size,
+                    tile_size, tile_size)));
+    texture.clear(sf::Color::Transparent);
+    texture.draw(layer);
+    texture.display();
+    return true;
+}
+
+/// Keeps texture alive until the frames recorded so far are drawn.
+void LayerCache::retire(std::unique_ptr<sf::RenderTexture> texture)
+{
+    m_retired.push_back(Retired{std::move(texture), m_frame});
+}
+
+/// Retires the least recently drawn tiles past MAX_TILES, and frees retired
+/// textures past MAX_TILES.
+void LayerCache::evict()
+{
+    while (m_tiles.size() > MAX_TILES) {
+        auto oldest = std::min_element(m_tiles.begin(), m_tiles.end(),
+                [] (const auto& lhs, const auto& rhs) {
+                    return lhs.second.last_frame < rhs.second.last_frame;
+                });
+        retire(std::move(oldest->second.texture));
+        m_tiles.erase(oldest);
+    }
+    // retired textures are in frame order, the oldest are drawn first
+    while (m_retired.size() > MAX_TILES
+            && m_retired.front().frame <= m_drawn_frame)
+        m_retired.erase(m_retired.begin());
+}
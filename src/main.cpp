@@ -7,11 +7,26 @@
  */
 
 #include "app.h"
+#include "concurrent_command_queue.h"
+#include "horde.h"
+#include "input_log.h"
+#include "conf.h"
+#include "offscreen_renderer.h"
 
+#include <cstddef>
 #include <stdexcept>
 #include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
 
-int main()
+namespace {
+    /// Threads and commands per thread of --command-stress.
+    constexpr std::size_t STRESS_PRODUCERS = 4;
+    constexpr std::size_t STRESS_COMMANDS = 100000;
+}
+
+int main(int argc, char* argv[])
 {
     // replace atof with std::stod for cmake
     //const double input_value = std::stod(argv[1]);
@@ -24,8 +39,72 @@ int main()
         //return 1;
     //}
     try {
-        Application app;
-        app.run();
+        /// --horde runs the horde stress mode headless, instead of the game.
+        /// @see parse_horde_config() for horde options.
+        /// --replay=<file> replays an input log headless, instead of the game.
+        /// --render[=<file>] renders the horde or replay offscreen, printing
+        /// the frame time and hash summary, and writing per-frame statistics
+        /// into file if given. Needs an X display on Linux, run under
+        /// xvfb-run -a on machines without one.
+        /// --record=<file> records the input of the game into an input log.
+        /// --tick-rate=<hz> sets the simulation rate, frames are interpolated.
+        /// --command-stress runs the stress test of ConcurrentCommandQueue,
+        /// exiting with 1 if commands were lost or reordered.
+        /// @see run_command_stress()
+        std::string_view record_filename;
+        std::string_view replay_filename;
+        std::string_view render_filename;
+        bool is_horde = false;
+        bool is_rendering = false;
+        sf::Time time_per_tick = conf::TIME_PER_FRAME;
+        for (int i = 1; i < argc; ++i) {
+            std::string_view arg(argv[i]);
+            if (arg == "--command-stress") {
+                return run_command_stress(STRESS_PRODUCERS, STRESS_COMMANDS,
+                        std::clog) ? 0 : 1;
+            } else if (arg == "--horde") {
+                is_horde = true;
+            } else if (arg.substr(0, 9) == "--replay=") {
+                replay_filename = arg.substr(9);
+            } else if (arg == "--render") {
+                is_rendering = true;
+            } else if (arg.substr(0, 9) == "--render=") {
+                is_rendering = true;
+                render_filename = arg.substr(9);
+            } else if (arg.substr(0, 9) == "--record=") {
+                record_filename = arg.substr(9);
+            } else if (arg.substr(0, 12) == "--tick-rate=") {
+                float tick_rate = std::stof(std::string(arg.substr(12)));
+                if (tick_rate <= 0.f)
+                    throw std::runtime_error("Tick rate must be positive");
+                time_per_tick = sf::seconds(1.f / tick_rate);
+            }
+        }
+        if (is_horde || !replay_filename.empty()) {
+            std::unique_ptr<OffscreenRenderer> renderer;
+            if (is_rendering)
+                renderer = std::make_unique<OffscreenRenderer>(
+                        conf::RESOLUTION_X, conf::RESOLUTION_Y);
+            if (is_horde)
+                run_horde(parse_horde_config(argc, argv), renderer.get());
+            else
+                run_replay(std::string(replay_filename), renderer.get());
+            if (renderer) {
+                renderer->print_summary(std::clog);
+                if (!render_filename.empty())
+                    renderer->write_report(std::string(render_filename));
+            }
+            return 0;
+        }
+        if (is_rendering)
+            throw std::runtime_error("--render needs --horde or --replay");
+        if (!record_filename.empty()) {
+            Application app{time_per_tick, std::string(record_filename)};
+            app.run();
+        } else {
+            Application app{time_per_tick};
+            app.run();
+        }
     } catch (std::exception& e) {
         std::cerr << "\nexception: " << e.what() << std::endl;
     }
@@ -0,0 +1,179 @@
+#include "offscreen_renderer.h"
+#include "world.h"
+
+#include <SFML/Config.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/System/Clock.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+namespace {
+    /// FNV-1a 64 bit parameters.
+    constexpr std::uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+    constexpr std::uint64_t FNV_PRIME = 1099511628211ull;
+
+    std::uint64_t fnv1a(std::uint64_t hash, const std::uint8_t* bytes,
+            std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i) {
+            hash ^= bytes[i];
+            hash *= FNV_PRIME;
+        }
+        return hash;
+    }
+
+    /// Hashes are printed as 16 hex digits, like in the report.
+    struct Hex {
+        std::uint64_t value;
+    };
+
+    std::ostream& operator<<(std::ostream& out, Hex hex)
+    {
+        std::ios::fmtflags flags = out.flags();
+        char fill = out.fill('0');
+        out << std::hex << std::setw(16) << hex.value;
+        out.flags(flags);
+        out.fill(fill);
+        return out;
+    }
+}
+
+/**
+ * @param unsigned int width, unsigned int height
+ * Size of the rendered frames in px, e.g. conf::RESOLUTION_X and
+ * conf::RESOLUTION_Y.
+ * @throw std::runtime_error if there is no X display, or the render texture
+ * can not be created.
+ * @note SFML creates OpenGL contexts through X on Linux, even for render
+ * textures: without a display it aborts instead of failing. Machines without
+ * one run under a virtual display, e.g. xvfb-run.
+ */
+OffscreenRenderer::OffscreenRenderer(unsigned int width, unsigned int height) :
+    m_texture(),
+    m_frame(),
+    m_frames()
+{
+#ifdef SFML_SYSTEM_LINUX
+    const char* display = std::getenv("DISPLAY");
+    if (display == nullptr || *display == '\0')
+        throw std::runtime_error("OffscreenRenderer - No X display (DISPLAY "
+                "is not set), run under a virtual display, e.g. "
+                "xvfb-run -a untitled-game --render ...");
+#endif
+    m_texture = std::make_unique<sf::RenderTexture>();
+    if (!m_texture->create(width, height))
+        throw std::runtime_error("OffscreenRenderer - Failed to create "
+                + std::to_string(width) + "x" + std::to_string(height)
+                + " render texture");
+}
+
+/**
+ * Records world into a DrawList and draws it into the render texture, like
+ * Application and RenderThread do for the window, then hashes the pixels.
+ * @return Returns the statistics of the rendered frame.
+ */
+const OffscreenRenderer::Frame& OffscreenRenderer::render(World& world)
+{
+    sf::Clock clock;
+    m_frame.clear();
+    // frames are drawn before the next one is recorded
+    m_frame.set_sequence(m_frames.size() + 1, m_frames.size());
+    world.draw(m_frame);
+    sf::Time record_time = clock.restart();
+
+    m_texture->clear();
+    m_frame.draw(*m_texture);
+    m_texture->display();
+    sf::Image image = m_texture->getTexture().copyToImage();
+    sf::Time render_time = clock.getElapsedTime();
+
+    m_frames.push_back(Frame{world.get_tick(), record_time, render_time,
+            hash_image(image)});
+    return m_frames.back();
+}
+
+const std::vector<OffscreenRenderer::Frame>& OffscreenRenderer::get_frames()
+    const
+{
+    return m_frames;
+}
+
+/**
+ * @return Returns the hash of all frame hashes in order, equal between runs
+ * only if every frame is.
+ */
+std::uint64_t OffscreenRenderer::get_combined_hash() const
+{
+    std::uint64_t hash = FNV_OFFSET_BASIS;
+    for (const Frame& frame : m_frames)
+        hash = fnv1a(hash, reinterpret_cast<const std::uint8_t*>(&frame.hash),
+                sizeof(frame.hash));
+    return hash;
+}
+
+/**
+ * Writes one line per frame, tab separated: frame, tick, record and render
+ * time in microseconds, and the frame hash.
+ */
+void OffscreenRenderer::write_report(std::ostream& out) const
+{
+    out << "frame\ttick\trecord_us\trender_us\thash\n";
+    for (std::size_t i = 0; i < m_frames.size(); ++i) {
+        const Frame& frame = m_frames[i];
+        out << i << "\t" << frame.tick
+            << "\t" << frame.record_time.asMicroseconds()
+            << "\t" << frame.render_time.asMicroseconds()
+            << "\t" << Hex{frame.hash} << "\n";
+    }
+}
+
+/**
+ * @throw std::runtime_error if filename can not be opened.
+ */
+void OffscreenRenderer::write_report(const std::string& filename) const
+{
+    std::ofstream file(filename);
+    if (!file)
+        throw std::runtime_error("OffscreenRenderer - Failed to open "
+                + filename);
+    write_report(file);
+}
+
+/**
+ * Prints the frame count, average and max render time, and the combined hash.
+ */
+void OffscreenRenderer::print_summary(std::ostream& out) const
+{
+    sf::Time total;
+    sf::Time max;
+    for (const Frame& frame : m_frames) {
+        sf::Time frame_time = frame.record_time + frame.render_time;
+        total += frame_time;
+        max = std::max(max, frame_time);
+    }
+    std::int64_t count = std::max<std::int64_t>(
+            static_cast<std::int64_t>(m_frames.size()), 1);
+    out << "Rendered " << m_frames.size() << " frames ("
+        << total.asMicroseconds() / count << " us/frame, max "
+        << max.asMicroseconds() << " us), hash " << Hex{get_combined_hash()}
+        << std::endl;
+}
+
+/**
+ * FNV-1a hash of the pixels of image, equal for equal images.
+ */
+std::uint64_t hash_image(const sf::Image& image)
+{
+    sf::Vector2u size = image.getSize();
+    std::uint64_t hash = FNV_OFFSET_BASIS;
+    hash = fnv1a(hash, reinterpret_cast<const std::uint8_t*>(&size),
+            sizeof(size));
+    if (size.x > 0 && size.y > 0)
+        hash = fnv1a(hash, image.getPixelsPtr(),
+                static_cast<std::size_t>(size.x) * size.y * 4);
+    return hash;
+}
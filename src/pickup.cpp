@@ -1,4 +1,5 @@
 #include "pickup.h"
+#include "sprite_batch.h"
 #include "data_tables.h"
 #include "category.h"
 #include "command_queue.h"
@@ -13,9 +14,9 @@ namespace {
 }
 
 Pickup::Pickup(Type type, const TextureHolder& textures) :
-    Entity(1),
+    Entity(1, NODE_TYPE),
     m_type(type),
-    m_sprite(textures.get(TABLE[type].texture))
+    m_sprite(textures.make_sprite(TABLE[type].texture))
 {
     /// Default constructor centers origin of sprite.
     center_origin(m_sprite);
@@ -36,10 +37,14 @@ sf::FloatRect Pickup::get_bounding_rect() const
     return get_world_transform().transformRect(m_sprite.getGlobalBounds());
 }
 
-void Pickup::apply(Creature& player) const
+/**
+ * Gets the effect of the pickup, to be applied by an EffectBuffer.
+ * @return Effect of the pickup type.
+ */
+Effect Pickup::get_effect() const
 {
-    /// Lookup TABLE by type & apply action to player.
-    TABLE[m_type].action(player);
+    /// Lookup TABLE by type.
+    return TABLE[m_type].effect;
 }
 
 void Pickup::draw_current(sf::RenderTarget& target, sf::RenderStates states)
@@ -47,3 +52,17 @@ void Pickup::draw_current(sf::RenderTarget& target, sf::RenderStates states)
 {
     target.draw(m_sprite, states);
 }
+
+void Pickup::collect_current(SpriteBatch& batch,
+        const sf::Transform& transform) const
+{
+    batch.add(m_sprite, transform);
+}
+
+/**
+ * @return Bounds of the sprite, relative to the Pickup.
+ */
+sf::FloatRect Pickup::get_cull_bounds() const
+{
+    return m_sprite.getGlobalBounds();
+}
@@ -1,32 +1,40 @@
 #include "player.h"
 #include "command_queue.h"
 #include "creature.h"
+#include "input_log.h"
 
 #include <map>
 #include <string>
 #include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <stdexcept>
 
-using namespace std::placeholders;
-
-struct PlayerMover {
-    PlayerMover(float vx, float vy) : velocity(vx, vy) {}
+/**
+ * @struct PlayerIntent
+ * All realtime input of one tick, applied to the player creature at once.
+ * @note direction is already normalized, diagonal movement is as fast as
+ * straight movement.
+ */
+struct PlayerIntent {
     void operator() (Creature& player, sf::Time) const
     {
-        player.accelerate(velocity * player.get_max_speed());
-        // uncomment to print current player velocity
-        std::cout << "Player velocity: (" << velocity.x * player.get_max_speed()
-            << ", " << velocity.y * player.get_max_speed() << ")\n";
+        player.accelerate(direction * player.get_max_speed());
+        if (actions & Player::MagicAttack)
+            player.attack();
     }
-    sf::Vector2f velocity;
+    sf::Vector2f direction;
+    unsigned int actions;
 };
 
 /**
  * @note Default LevelStatus of Player is InProgress. Initialized in default
  * constructor.
  */
-Player::Player() : m_current_level_status(InProgress)
+Player::Player() :
+    m_current_level_status(InProgress),
+    m_recorder(nullptr),
+    m_target()
 {
     /// Try to set initial keybindings.
     try {
@@ -64,23 +72,116 @@ void Player::handle_event(const sf::Event& event, CommandQueue& commands)
         // check if pressed key appears in keybinding, trigger command if so
         auto found = m_keybinding.find(event.key.code);
         if (found != m_keybinding.end() && !is_realtime_action(found->second))
-            commands.push(m_actionbinding[found->second]);
+            trigger_action(found->second, commands);
     }
 }
 
+/**
+ * Folds all realtime input of the tick into one intent command.
+ * @see push_intent()
+ */
 void Player::handle_realtime_input(CommandQueue& commands)
 {
     /** @brief Traverses all assigned keys and checks if they are pressed. */
-    for (auto pair : m_keybinding) {
-        /** @brief If key is pressed, lookup action and trigger correspoding
-         * command. */
-        if (sf::Keyboard::isKeyPressed(pair.first)
-                && is_realtime_action(pair.second)) {
-            // print detection of realtime input
-            std::cout << "Realtime input detected!\n";
-            commands.push(m_actionbinding[pair.second]);
-        }
+    unsigned int actions = None;
+    for (const auto& pair : m_keybinding) {
+        if (is_realtime_action(pair.second)
+                && sf::Keyboard::isKeyPressed(pair.first))
+            actions |= pair.second;
     }
+    if (actions == None)
+        return;
+
+    push_intent(actions, commands);
+    if (m_recorder != nullptr)
+        m_recorder->record(actions);
+}
+
+/**
+ * Pushes the commands of recorded actions, as if their keys were pressed.
+ * @param unsigned int actions
+ * Bitmask of Action, as recorded by InputRecorder.
+ * @see run_replay()
+ */
+void Player::replay_actions(unsigned int actions, CommandQueue& commands)
+{
+    unsigned int realtime_actions = None;
+    for (unsigned int bit = 1; bit <= Map; bit <<= 1) {
+        if (!(actions & bit))
+            continue;
+        if (is_realtime_action(static_cast<Action>(bit)))
+            realtime_actions |= bit;
+        else if (auto found = m_actionbinding.find(static_cast<Action>(bit));
+                found != m_actionbinding.end())
+            commands.push(found->second.clone());
+    }
+    if (realtime_actions != None)
+        push_intent(realtime_actions, commands);
+}
+
+/**
+ * Records every action triggered from now on into recorder.
+ * @param InputRecorder* recorder
+ * Recorder to record into, nullptr to stop recording.
+ */
+void Player::set_recorder(InputRecorder* recorder)
+{
+    m_recorder = recorder;
+}
+
+InputRecorder* Player::get_recorder() const
+{
+    return m_recorder;
+}
+
+/**
+ * Addresses player commands to target directly, instead of broadcasting them
+ * to Category::Player.
+ * @see World::get_player_handle()
+ */
+void Player::set_target(EntityHandle target)
+{
+    m_target = target;
+}
+
+/// Push the command bound to action, and record action if recording.
+void Player::trigger_action(Action action, CommandQueue& commands)
+{
+    auto found = m_actionbinding.find(action);
+    if (found == m_actionbinding.end())
+        return;
+    Command command = found->second.clone();
+    command.target = m_target;
+    commands.push(std::move(command));
+    if (m_recorder != nullptr)
+        m_recorder->record(action);
+}
+
+/**
+ * Pushes one command applying all realtime actions of the tick: movement is
+ * summed into one normalized direction, and attacks are applied alongside.
+ * @param unsigned int actions
+ * Bitmask of realtime Action(s).
+ * @attention Player speed is obtained from data_tables.cpp.
+ * @see Creature::get_max_speed(), Creature::check_projectile_launch()
+ */
+void Player::push_intent(unsigned int actions, CommandQueue& commands)
+{
+    // @note y-axis up/down pos/neg is inverse!
+    sf::Vector2f direction(
+            static_cast<float>((actions & MoveRight) != 0)
+            - static_cast<float>((actions & MoveLeft) != 0),
+            static_cast<float>((actions & MoveDown) != 0)
+            - static_cast<float>((actions & MoveUp) != 0));
+    // if moving diagonally, reduce velocity (to always have same velocity)
+    if (direction.x != 0.f && direction.y != 0.f)
+        direction /= std::sqrt(2.f);
+
+    Command intent;
+    intent.category = Category::Player;
+    intent.target = m_target;
+    intent.action = derived_action<Creature>(PlayerIntent{direction, actions});
+    commands.push(std::move(intent));
 }
 
 void Player::assign_key(Action action, sf::Keyboard::Key key)
@@ -114,35 +215,12 @@ char* Player::print_assigned_key(Action action) const
 }
 
 /**
- * @attention Player speed is obtained from data_tables.cpp. Correct direction
- * is achieved by multiplying by positive or negative one on the correct axis.
- * @see PlayerMover, Creature::get_max_speed(), data_tables.cpp
- * @note Will attack every frame.
- * @see Creature::check_projectile_launch() to sync with delta time.
+ * Binds commands to the actions triggered by events.
+ * @note Realtime actions (movement, attacks) are not bound, they are folded
+ * into one intent per tick by push_intent().
+ * @todo Bind Inventory and Map once implemented.
  */
 void Player::initialize_actions() {
-    /** @brief Movement commands increment and decrement player speed. */
-    // @note y-axis up/down pos/neg is inverse!
-	m_actionbinding[MoveUp].action = derived_action<Creature>(
-            PlayerMover(0.f, -1.f));
-    std::cout << "Player action initialized: Move up\n";
-	m_actionbinding[MoveDown].action = derived_action<Creature>(
-            PlayerMover(0.f, +1.f));
-    std::cout << "Player action initialized: Move down\n";
-    m_actionbinding[MoveLeft].action = derived_action<Creature>(
-            PlayerMover(-1.f, 0.f));
-    std::cout << "Player action initialized: Move left\n";
-	m_actionbinding[MoveRight].action = derived_action<Creature>(
-            PlayerMover(+1.f, 0.f));
-    std::cout << "Player action initialized: Move right\n";
-
-    // attack actions...
-    // std::bind binds the para "_1" to always be the para for &attack ...
-    // -> Creature::attack(std::placeholders::_1);
-    m_actionbinding[MagicAttack].action = derived_action<Creature>(
-            std::bind(&Creature::attack, _1));
-    // Creature::check_projectile_launch() ->
-    // guards to properly attack based on delta time
 }
 
 /**
@@ -1,4 +1,5 @@
 #include "projectile.h"
+#include "sprite_batch.h"
 #include "data_tables.h"
 #include "utility.h"
 #include "r_holders.h"
@@ -15,38 +16,76 @@ namespace {
 }
 
 Projectile::Projectile(Type type, const TextureHolder& textures) :
-    Entity(1),
+    Entity(1, NODE_TYPE),
     m_type(type),
-    m_sprite(textures.get(TABLE[type].texture)),
-    m_target_direction()
+    m_sprite(textures.make_sprite(TABLE[type].texture)),
+    m_target_position(),
+    m_has_target(false),
+    m_retarget_countdown(sf::Time::Zero)
 {
     center_origin(m_sprite);
 }
 
+/**
+ * Steer the projectile torwards position, until the next target
+ * re-evaluation.
+ */
 void Projectile::guide_torwards(sf::Vector2f position)
 {
     assert(is_guided());
-    m_target_direction = unit_vector(position - get_world_position());
+    m_target_position = position;
+    m_has_target = true;
 }
 
 bool Projectile::is_guided() const {
     return m_type == Projectile::PlayerFire;
 }
 
+/**
+ * Check if the guided projectile should (re-)acquire a target this tick.
+ * @return True if guided and the retarget countdown is over, false if not.
+ * @see World::guide_projectiles().
+ */
+bool Projectile::is_retargeting() const
+{
+    return is_guided() && m_retarget_countdown <= sf::Time::Zero;
+}
+
+/**
+ * Restart the retarget countdown, whether a target was found or not - so that
+ * a projectile with nothing in range does not query every tick.
+ */
+void Projectile::reset_retarget_countdown()
+{
+    m_retarget_countdown = TABLE[m_type].retarget_interval;
+}
+
+/**
+ * @return Returns the distance guided projectiles acquire targets within.
+ */
+float Projectile::get_guide_range() const
+{
+    return TABLE[m_type].guide_range;
+}
+
 void Projectile::update_current(sf::Time delta_time, CommandQueue& commands)
 {
-    /* TODO: implement/understand guiding and math + calc
     if (is_guided()) {
-        const float approach_rate = 125.f;
-        sf::Vector2f new_velocity = unit_vector2f(approach_rate
-                * delta_timfe.asSeconds() * m_target_direction + get_velocity());
-        new_velocity *= get_max_speed();
-        float angle = std::atan2(new_velocity.y, new_velocity.x);
-
-        set_rotation(to_degree(angle) + 90.f);
-        set_velocity(new_velocity);
+        m_retarget_countdown -= delta_time;
+        sf::Vector2f offset = m_target_position - get_world_position();
+        /// Turn velocity torwards the target, at approach rate, keeping speed.
+        if (m_has_target && offset != sf::Vector2f(0.f, 0.f)) {
+            const float approach_rate = 200.f;
+            sf::Vector2f new_velocity = unit_vector(approach_rate
+                    * delta_time.asSeconds() * unit_vector(offset)
+                    + get_velocity());
+            new_velocity *= get_max_speed();
+            float angle = std::atan2(new_velocity.y, new_velocity.x);
+
+            setRotation(to_degree(angle) + 90.f);
+            set_velocity(new_velocity);
+        }
     }
-    */
     Entity::update_current(delta_time, commands);
 }
 
@@ -56,6 +95,20 @@ void Projectile::draw_current(sf::RenderTarget& target, sf::RenderStates states)
     target.draw(m_sprite, states);
 }
 
+void Projectile::collect_current(SpriteBatch& batch,
+        const sf::Transform& transform) const
+{
+    batch.add(m_sprite, transform);
+}
+
+/**
+ * @return Bounds of the sprite, relative to the Projectile.
+ */
+sf::FloatRect Projectile::get_cull_bounds() const
+{
+    return m_sprite.getGlobalBounds();
+}
+
 unsigned int Projectile::get_category() const
 {
     if (m_type == Type::EnemyFire)
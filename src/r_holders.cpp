@@ -1,5 +1,15 @@
 #include "r_holders.h"
 
+#include <algorithm>
+
+/// Anonymous namespace for atlas packing constants.
+namespace {
+    /// Largest atlas page side, clamped to the maximum texture size.
+    constexpr unsigned int ATLAS_PAGE_SIZE = 2048;
+    /// Transparent pixels between regions, so filtering does not bleed.
+    constexpr unsigned int ATLAS_PADDING = 1;
+}
+
 void TextureHolder::load(Textures::ID id, const std::string& filename)
 {
     // create texture
@@ -28,6 +38,104 @@ void TextureHolder::load(Textures::ID id, const std::string& filename,
     insert_texture(id, std::move(texture));
 }
 
+/**
+ * Loads the image of filename, to be packed into an atlas page by
+ * build_atlas().
+ * @note IDs loading the same filename share one region.
+ */
+void TextureHolder::load_region(Textures::ID id, const std::string& filename)
+{
+    if (m_pending_images.find(filename) == m_pending_images.end()) {
+        sf::Image image;
+        if (!image.loadFromFile(filename))
+            throw std::runtime_error("TextureHolder::load_region - Failed to "
+                    "load " + filename);
+        m_pending_images.emplace(filename, std::move(image));
+    }
+    auto inserted = m_pending_regions.insert(std::make_pair(id, filename));
+    // check that id is not already loaded
+    assert(inserted.second && m_region_map.find(id) == m_region_map.end());
+}
+
+/**
+ * Rect packs all images loaded by load_region() into atlas pages: images are
+ * sorted by height and placed on shelves, left to right, a new page is
+ * started when a page is full.
+ */
+void TextureHolder::build_atlas()
+{
+    if (m_pending_images.empty())
+        return;
+    unsigned int page_size = std::min(ATLAS_PAGE_SIZE,
+            sf::Texture::getMaximumSize());
+
+    // tallest first, so shelves waste little height
+    std::vector<std::pair<const std::string*, const sf::Image*>> images;
+    for (const auto& pair : m_pending_images)
+        images.push_back(std::make_pair(&pair.first, &pair.second));
+    std::stable_sort(images.begin(), images.end(),
+            [] (const auto& lhs, const auto& rhs) {
+                return lhs.second->getSize().y > rhs.second->getSize().y;
+            });
+
+    // placement of each image: page index and rect on the page
+    std::map<std::string, std::pair<std::size_t, sf::IntRect>> placements;
+    std::vector<unsigned int> page_heights;
+    unsigned int x = 0;
+    unsigned int y = 0;
+    unsigned int shelf_height = 0;
+    for (const auto& [filename, image] : images) {
+        sf::Vector2u size = image->getSize();
+        if (size.x + ATLAS_PADDING > page_size
+                || size.y + ATLAS_PADDING > page_size)
+            throw std::runtime_error("TextureHolder::build_atlas - Too large "
+                    "for an atlas page " + *filename);
+        // next shelf, or next page
+        if (x + size.x > page_size) {
+            x = 0;
+            y += shelf_height;
+            shelf_height = 0;
+        }
+        if (page_heights.empty() || y + size.y > page_size) {
+            page_heights.push_back(0);
+            x = 0;
+            y = 0;
+            shelf_height = 0;
+        }
+        placements[*filename] = std::make_pair(page_heights.size() - 1,
+                sf::IntRect(x, y, size.x, size.y));
+        x += size.x + ATLAS_PADDING;
+        shelf_height = std::max(shelf_height, size.y + ATLAS_PADDING);
+        page_heights.back() = std::max(page_heights.back(), y + size.y);
+    }
+
+    // compose pages, then upload them
+    std::vector<sf::Image> pages(page_heights.size());
+    for (std::size_t i = 0; i < pages.size(); ++i)
+        pages[i].create(page_size, page_heights[i], sf::Color::Transparent);
+    for (const auto& [filename, placement] : placements)
+        pages[placement.first].copy(m_pending_images[filename],
+                placement.second.left, placement.second.top);
+
+    std::size_t first_page = m_atlas_pages.size();
+    for (const sf::Image& page : pages) {
+        std::unique_ptr<sf::Texture> texture(new sf::Texture());
+        if (!texture->loadFromImage(page))
+            throw std::runtime_error("TextureHolder::build_atlas - Failed to "
+                    "create atlas page");
+        m_atlas_pages.push_back(std::move(texture));
+    }
+    for (const auto& [id, filename] : m_pending_regions) {
+        const auto& placement = placements[filename];
+        m_region_map[id] = TextureRegion{
+            m_atlas_pages[first_page + placement.first].get(),
+            placement.second};
+    }
+
+    m_pending_images.clear();
+    m_pending_regions.clear();
+}
+
 sf::Texture& TextureHolder::get(Textures::ID id)
 {
     // if found, will recieve id and confirm. if not, recieve end() & assert
@@ -48,6 +156,26 @@ const sf::Texture& TextureHolder::get(Textures::ID id) const
     return *found->second;
 }
 
+/**
+ * @return Returns the atlas page and sub-rect of id, loaded by load_region().
+ * @attention Only valid after build_atlas().
+ */
+const TextureRegion& TextureHolder::get_region(Textures::ID id) const
+{
+    auto found = m_region_map.find(id);
+    assert(found != m_region_map.end());
+    return found->second;
+}
+
+/**
+ * @return Returns a sprite addressing the atlas region of id.
+ */
+sf::Sprite TextureHolder::make_sprite(Textures::ID id) const
+{
+    const TextureRegion& region = get_region(id);
+    return sf::Sprite(*region.texture, region.rect);
+}
+
 void TextureHolder::insert_texture(Textures::ID id,
         std::unique_ptr<sf::Texture> texture)
 {
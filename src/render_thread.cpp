@@ -0,0 +1,139 @@
+#include "render_thread.h"
+
+#include <SFML/Graphics/RenderWindow.hpp>
+
+#include <utility>
+
+RenderThread::RenderThread(sf::RenderWindow& window) :
+    m_window(window),
+    m_frames(),
+    m_back(0),
+    m_pending(1),
+    m_front(2),
+    m_has_pending(false),
+    m_running(false),
+    m_published_count(0),
+    m_drawn_count(0),
+    m_mutex(),
+    m_frame_published(),
+    m_frame_drawn(),
+    m_thread()
+{
+}
+
+RenderThread::~RenderThread()
+{
+    stop();
+}
+
+/**
+ * Hands the window's OpenGL context over to the render thread and starts it.
+ */
+void RenderThread::start()
+{
+    if (m_thread.joinable())
+        return;
+    // a context can only be active in one thread
+    m_window.setActive(false);
+    m_running = true;
+    m_thread = std::thread(&RenderThread::run, this);
+}
+
+/**
+ * Stops the render thread after its current frame, and takes the window's
+ * OpenGL context back to the calling thread.
+ */
+void RenderThread::stop()
+{
+    if (!m_thread.joinable())
+        return;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_running = false;
+    }
+    m_frame_published.notify_one();
+    m_thread.join();
+    m_window.setActive(true);
+}
+
+/**
+ * @return Returns the empty back frame, to be recorded and then published.
+ * Its sequence numbers fence resources of earlier frames, see
+ * DrawList::set_sequence().
+ */
+DrawList& RenderThread::begin_frame()
+{
+    DrawList& frame = m_frames[m_back];
+    frame.clear();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // while stopped nothing is being drawn, every frame counts as drawn
+    frame.set_sequence(m_published_count + 1, m_thread.joinable()
+            ? m_drawn_count : m_published_count);
+    return frame;
+}
+
+/**
+ * Publishes the back frame, replacing the pending frame if it was not drawn
+ * yet.
+ * @note Synchronous frames block until drawn, see DrawList::set_synchronous().
+ */
+void RenderThread::publish()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    bool synchronous = m_frames[m_back].is_synchronous();
+    std::swap(m_back, m_pending);
+    m_has_pending = true;
+    std::uint64_t published = ++m_published_count;
+    m_frame_published.notify_one();
+    if (synchronous && m_running)
+        m_frame_drawn.wait(lock, [this, published] {
+            return m_drawn_count >= published || !m_running;
+        });
+}
+
+/**
+ * Blocks until every published frame is drawn (or replaced), so nothing
+ * recorded into them is used anymore, e.g. before destroying what a frame
+ * points to. Returns at once while stopped.
+ */
+void RenderThread::wait_idle()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_frame_drawn.wait(lock, [this] {
+        return m_drawn_count >= m_published_count || !m_running;
+    });
+}
+
+/**
+ * Render loop: waits for a published frame, draws and displays it.
+ */
+void RenderThread::run()
+{
+    m_window.setActive(true);
+    for (;;) {
+        std::uint64_t drawing;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_frame_published.wait(lock, [this] {
+                return m_has_pending || !m_running;
+            });
+            if (!m_running)
+                break;
+            std::swap(m_front, m_pending);
+            m_has_pending = false;
+            drawing = m_published_count;
+        }
+
+        m_window.clear();
+        m_frames[m_front].draw(m_window);
+        m_window.display();
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_drawn_count = drawing;
+        }
+        m_frame_drawn.notify_one();
+    }
+    m_window.setActive(false);
+    m_frame_drawn.notify_one();
+}
@@ -1,4 +1,6 @@
 #include "s_game.h"
+#include "draw_list.h"
+#include "input_log.h"
 
 #include <iostream>
 
@@ -7,19 +9,24 @@ GameState::GameState(StateStack& stack, Context context) :
     m_world(*context.window, *context.fonts),
     m_player(*context.player)
 {
+    /// Player commands are delivered to the player creature directly.
+    m_player.set_target(m_world.get_player_handle());
     // print successful state creation
     std::cout << "Game stated created!\n";
 }
 
-void GameState::draw()
+void GameState::draw(DrawList& frame)
 {
-    m_world.draw();
+    m_world.draw(frame);
 }
 
 bool GameState::update(sf::Time delta_time)
 {
     /// Update and realtime input done in same update cycle of game state.
     m_world.update(delta_time);
+    /// Input from now on is executed in the next tick, record it as such.
+    if (InputRecorder* recorder = m_player.get_recorder())
+        recorder->begin_tick(m_world.get_tick());
     /// Get commands from command queue, then handle input.
     CommandQueue& commands = m_world.get_command_queue();
     m_player.handle_realtime_input(commands);
@@ -29,6 +36,15 @@ bool GameState::update(sf::Time delta_time)
     return true;
 }
 
+/**
+ * The world is not updated (e.g. paused), so it is drawn where it is instead
+ * of interpolating the last tick over again.
+ */
+void GameState::skip_update()
+{
+    m_world.store_previous_positions();
+}
+
 bool GameState::handle_event(const sf::Event& event)
 {
     // game input handling
@@ -40,11 +56,23 @@ bool GameState::handle_event(const sf::Event& event)
             && event.key.code == sf::Keyboard::Escape)
         request_push_stack(States::Pause);
 
+    /// F3 toggles the debug overlay of the world.
+    if (event.type == sf::Event::KeyPressed
+            && event.key.code == sf::Keyboard::F3)
+        m_world.get_debug_draw().toggle();
+
     return true;
 }
 
+/**
+ * @note A recording covers one game session, it is closed with the game state.
+ */
 GameState::~GameState()
 {
+    if (InputRecorder* recorder = m_player.get_recorder()) {
+        recorder->close();
+        m_player.set_recorder(nullptr);
+    }
     std::cout << "Game state has been destroyed!" << std::endl;
 }
 
@@ -1,4 +1,5 @@
 #include "s_loading.h"
+#include "draw_list.h"
 #include "utility.h"
 #include "r_holders.h"
 
@@ -13,7 +14,7 @@ LoadingState::LoadingState(StateStack& stack, Context context) :
     // get &font from context
     sf::Font& font = context.fonts->get(Fonts::Main);
     // set view to size of window
-    sf::Vector2f view_size = window.getView().getSize();
+    sf::Vector2f view_size = window.getDefaultView().getSize();
 
     // loading text...
     m_loading_text.setFont(font);
@@ -40,16 +41,16 @@ LoadingState::LoadingState(StateStack& stack, Context context) :
     m_loading_task.execute();
 }
 
-void LoadingState::draw()
+void LoadingState::draw(DrawList& frame)
 {
     // get window (already created) from context
     sf::RenderWindow& window = *get_context().window;
     // set window view to full screen (default view of window)
-    window.setView(window.getDefaultView());
+    frame.set_view(window.getDefaultView());
     // draw loading screen assets...
-    window.draw(m_loading_text);
-    window.draw(m_progress_bar_background);
-    window.draw(m_progress_bar);
+    frame.add(m_loading_text);
+    frame.add(m_progress_bar_background);
+    frame.add(m_progress_bar);
 }
 
 bool LoadingState::update(sf::Time delta_time)
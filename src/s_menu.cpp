@@ -1,4 +1,5 @@
 #include "s_menu.h"
+#include "draw_list.h"
 #include "utility.h"
 #include "r_holders.h"
 
@@ -52,17 +53,17 @@ MenuState::MenuState(StateStack& stack, Context context) :
     update_option_text();
 }
 
-void MenuState::draw()
+void MenuState::draw(DrawList& frame)
 {
     // get context of window, already in mem, don't recreate
     sf::RenderWindow& window = *get_context().window;
 
     // draw menu screen and set view
-    window.setView(window.getDefaultView());
-    window.draw(m_background_sprite);
+    frame.set_view(window.getDefaultView());
+    frame.add(m_background_sprite);
     // for each menu option draw
     for (const sf::Text& text : m_options)
-        window.draw(text);
+        frame.add(text);
 }
 
 /**
@@ -1,4 +1,5 @@
 #include "s_pause.h"
+#include "draw_list.h"
 #include "r_holders.h"
 #include "utility.h"
 #include "imguistyle.h"
@@ -15,12 +16,9 @@ PauseState::PauseState(StateStack& stack, Context context) :
     m_paused_text(),
     m_instruction_text()
 {
-    // set view to full size of render window for pause screen
-    m_window.setView(m_window.getDefaultView());
-
     // get res from existing context
     sf::Font& font = context.fonts->get(Fonts::Main);
-    sf::Vector2f view_size = context.window->getView().getSize();
+    sf::Vector2f view_size = context.window->getDefaultView().getSize();
 
     // pause screen/menu...
     m_paused_text.setFont(font);
@@ -41,24 +39,29 @@ PauseState::PauseState(StateStack& stack, Context context) :
     ImGui::SetupImGuiStyle();
 }
 
-void PauseState::draw()
+void PauseState::draw(DrawList& frame)
 {
     // get &window from context & set full screen (default view)
     sf::RenderWindow& window = *get_context().window;
-    window.setView(window.getDefaultView());
+    frame.set_view(window.getDefaultView());
 
     // opacity layer over paused game
     sf::RectangleShape background_shape;
     // rgba (0, 0, 0, alpha val for opacity)
     background_shape.setFillColor(sf::Color(0, 0, 0, 150));
     // size of layer = size of window
-    background_shape.setSize(window.getView().getSize());
+    background_shape.setSize(window.getDefaultView().getSize());
 
     // draw pause screen assets
-    window.draw(background_shape);
-    window.draw(m_paused_text);
-    window.draw(m_instruction_text);
-    ImGui::SFML::Render(m_window); // frame ready -> now render in render loop
+    frame.add(background_shape);
+    frame.add(m_paused_text);
+    frame.add(m_instruction_text);
+    // gui is rendered by the render thread, imgui state is shared with update
+    // so wait for it
+    frame.add([] (sf::RenderTarget& target) {
+        ImGui::SFML::Render(target); // frame ready -> now render in render loop
+    });
+    frame.set_synchronous();
 }
 
 /**
@@ -98,7 +101,7 @@ bool PauseState::handle_event(const sf::Event& event)
 void PauseState::gui_frame() {
     // (left) gui_pos + gui_size + (right) gui_pos = 1.0, to center gui window
     sf::Vector2f gui_size =
-        static_cast<sf::Vector2f>(m_window.getView().getSize());
+        static_cast<sf::Vector2f>(m_window.getDefaultView().getSize());
     sf::Vector2f gui_pos = gui_size;
     /* std::cout << "View size: " << gui_size.x << "x*" << gui_size.y << "y\n"; */
     scale_vector2f(gui_pos, 0.2f);
@@ -1,4 +1,5 @@
 #include "s_settings.h"
+#include "draw_list.h"
 #include "utility.h"
 #include "r_holders.h"
 #include "imguistyle.h"
@@ -20,9 +21,6 @@ SettingsState::SettingsState(StateStack& stack, Context context) :
     m_action(Player::Action::None),
     m_assigning_keys(false)
 {
-
-    // set view to full size of render window
-    m_window.setView(m_window.getDefaultView());
     // set different background sprite if prev state is in-game
     if (request_prev_state() == States::Game
             || request_prev_state() == States::Loading
@@ -47,7 +45,7 @@ SettingsState::SettingsState(StateStack& stack, Context context) :
     // default gui size & pos:
     // (left) gui_pos + gui_size + (right) gui_pos = 1.0, to center gui window
     m_gui_size = m_gui_pos
-        = static_cast<sf::Vector2f>(m_window.getView().getSize());
+        = static_cast<sf::Vector2f>(m_window.getDefaultView().getSize());
     std::cout << "View size: " << m_gui_size.x << "x*" << m_gui_size.y << "y\n";
 
     scale_vector2f(m_gui_size, 0.6f);
@@ -58,12 +56,17 @@ SettingsState::SettingsState(StateStack& stack, Context context) :
         << std::endl;
 }
 
-void SettingsState::draw()
+void SettingsState::draw(DrawList& frame)
 {
     // draw background
-    m_window.draw(m_background_sprite);
-    // render gui
-    ImGui::SFML::Render(m_window); // frame ready -> now render in render loop
+    frame.set_view(m_window.getDefaultView());
+    frame.add(m_background_sprite);
+    // render gui on the render thread, imgui state is shared with update so
+    // wait for it
+    frame.add([] (sf::RenderTarget& target) {
+        ImGui::SFML::Render(target); // frame ready -> now render in render loop
+    });
+    frame.set_synchronous();
 }
 
 bool SettingsState::update(sf::Time delta_time)
@@ -1,4 +1,6 @@
 #include "s_stack.h"
+#include "draw_list.h"
+#include "render_thread.h"
 
 #include <cassert>
 
@@ -36,21 +38,26 @@ void StateStack::handle_event(const sf::Event& event)
 
 void StateStack::update(sf::Time delta_time)
 {
-    // reverse it from end to begin, stop if state.update returns false
-    for (auto it = m_stack.rbegin(); it != m_stack.rend(); ++it)
-        if (!(*it)->update(delta_time))
-            break;
+    // reverse it from end to begin, states below one whose update returns
+    // false are not updated, but still told so
+    bool is_updating = true;
+    for (auto it = m_stack.rbegin(); it != m_stack.rend(); ++it) {
+        if (is_updating)
+            is_updating = (*it)->update(delta_time);
+        else
+            (*it)->skip_update();
+    }
     apply_pending_changes();
 }
 
-void StateStack::draw()
+void StateStack::draw(DrawList& frame)
 {
     // draw all active states from bottom to top (top on top)
     for (State::Ptr& state : m_stack) {
         // first, clear state by drawing black rect (implemented in clear())
         //state->clear();
         // then safe to draw new state
-        state->draw();
+        state->draw(frame);
     }
 }
 
@@ -100,11 +107,15 @@ void StateStack::apply_pending_changes()
             m_stack.push_back(create_state(change.state_id));
             m_stack_index.push_back(change.state_id);
             break;
+        // frames published but not drawn yet point into the state, wait for
+        // the render thread to be done with them before destroying it
         case Pop:
+            m_context.render_thread->wait_idle();
             m_stack.pop_back();
             m_stack_index.pop_back();
             break;
         case Clear:
+            m_context.render_thread->wait_idle();
             m_stack.clear();
             m_stack_index.clear();
             break;
@@ -1,4 +1,5 @@
 #include "s_title.h"
+#include "draw_list.h"
 #include "r_holders.h"
 #include "utility.h"
 
@@ -25,17 +26,17 @@ TitleState::TitleState(StateStack& stack, Context context) :
     m_text.setPosition(640, 600);
 }
 
-void TitleState::draw()
+void TitleState::draw(DrawList& frame)
 {
     // &window = &context.window
     sf::RenderWindow& window = *get_context().window;
     // make sure view is set to initial resolution
-    window.setView(window.getDefaultView());
-    window.draw(m_background_sprite);
+    frame.set_view(window.getDefaultView());
+    frame.add(m_background_sprite);
 
     // bool t/f to flicker text
     if (m_show_text)
-        window.draw(m_text);
+        frame.add(m_text);
 }
 
 bool TitleState::update(sf::Time delta_time)
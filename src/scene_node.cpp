@@ -2,16 +2,16 @@
 #include "command.h"
 #include "utility.h"
 #include "command_queue.h"
+#include "sprite_batch.h"
+#include "debug_draw.h"
 
-/// RenderTarget, RectangleShape, and Color only needed locally for the
-/// implementation of get_bounding_rect().
+/// RenderTarget only needed locally for the implementation of draw().
 #include <SFML/Graphics/RenderTarget.hpp>
-#include <SFML/Graphics/RectangleShape.hpp>
-#include <SFML/Graphics/Color.hpp>
 
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <iterator>
 
 /**
  * @note Collision between nodes on the scene graph are checked by (1) checking
@@ -19,8 +19,10 @@
  * and (3) iterating through the set to differentiate between the collision's
  * categories
  */
-SceneNode::SceneNode(Category::Type category) :
-    m_children(), m_parent(nullptr), m_default_category(category) {}
+SceneNode::SceneNode(Category::Type category, NodeType::Type node_type) :
+    m_children(), m_parent(nullptr), m_default_category(category),
+    m_node_type(node_type), m_previous_position(),
+    m_has_previous_position(false) {}
 // https://stackoverflow.com/questions/45583473/include-errors-detected-in-vscode
 
 void SceneNode::attach_child(Ptr child) {
@@ -46,6 +48,52 @@ SceneNode::Ptr SceneNode::detach_child(const SceneNode& node)
     return result;
 }
 
+/**
+ * Detach a batch of children in one sweep over the children container.
+ * @param first, last Range of nodes to detach, must all be children of this
+ * node. Range is sorted in place.
+ * @param detached Container the detached nodes are moved into, so the caller
+ * decides when to free them.
+ * @note Keeps the order of the remaining children (draw order).
+ */
+void SceneNode::detach_children(std::vector<SceneNode*>::iterator first,
+        std::vector<SceneNode*>::iterator last, std::vector<Ptr>& detached)
+{
+    std::sort(first, last);
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < m_children.size(); ++i) {
+        if (std::binary_search(first, last, m_children[i].get())) {
+            m_children[i]->m_parent = nullptr;
+            detached.push_back(std::move(m_children[i]));
+        } else {
+            // compact remaining children to the front
+            if (kept != i)
+                m_children[kept] = std::move(m_children[i]);
+            ++kept;
+        }
+    }
+    // check all nodes were children of this node
+    assert(m_children.size() - kept
+            == static_cast<std::size_t>(std::distance(first, last)));
+    m_children.resize(kept);
+}
+
+/**
+ * @return Returns the parent of the scene node, nullptr if not attached.
+ */
+SceneNode* SceneNode::get_parent() const
+{
+    return m_parent;
+}
+
+/**
+ * @return Returns the count of direct children of the scene node.
+ */
+std::size_t SceneNode::get_child_count() const
+{
+    return m_children.size();
+}
+
 /// Public update interface for private update fn.
 void SceneNode::update(sf::Time dt, CommandQueue& commands)
 {
@@ -53,6 +101,19 @@ void SceneNode::update(sf::Time dt, CommandQueue& commands)
     update_children(dt, commands);
 }
 
+/**
+ * Stores the position of the node and its children, called at the start of a
+ * tick. Drawing interpolates from these to the positions after the tick.
+ * @see get_interpolated_transform()
+ */
+void SceneNode::store_previous_positions()
+{
+    m_previous_position = getPosition();
+    m_has_previous_position = true;
+    for (Ptr& child : m_children)
+        child->store_previous_positions();
+}
+
 void SceneNode::update_current(sf::Time, CommandQueue&)
 {
     // do nothing by default
@@ -89,6 +150,87 @@ void SceneNode::draw_children(sf::RenderTarget& target, sf::RenderStates states)
         child->draw(target, states);
 }
 
+/**
+ * Collects the node and its children into batch, to be drawn with one draw
+ * call per texture.
+ * @param const sf::Transform& transform
+ * Absolute transform of the parent node.
+ * @note Nodes with cull bounds outside the cull rect of batch are skipped with
+ * all their children. Bounds are made absolute with the transform already
+ * combined for collecting, not with get_world_transform().
+ * @see SpriteBatch
+ */
+void SceneNode::collect(SpriteBatch& batch, const sf::Transform& transform)
+    const
+{
+    // combine the parent's absolute transformation with the current node's
+    // relative one, like draw()
+    sf::Transform combined = transform
+        * get_interpolated_transform(batch.get_interpolation());
+    sf::FloatRect bounds = get_cull_bounds();
+    if (bounds.width > 0.f && bounds.height > 0.f
+            && batch.cull(combined.transformRect(bounds)))
+        return;
+    collect_current(batch, combined);
+    for (const Ptr& child : m_children)
+        child->collect(batch, combined);
+}
+
+void SceneNode::collect_current(SpriteBatch&, const sf::Transform&) const
+{
+    // do nothing by default
+}
+
+/**
+ * Collects the bounds of the node and its children into debug, at their
+ * interpolated positions like collect(). Nodes without bounds (see
+ * get_cull_bounds()) only add what debug_draw_current() adds.
+ */
+void SceneNode::collect_debug(DebugDraw& debug, const sf::Transform& transform,
+        float interpolation) const
+{
+    sf::Transform combined = transform
+        * get_interpolated_transform(interpolation);
+    sf::FloatRect bounds = get_cull_bounds();
+    if (bounds.width > 0.f && bounds.height > 0.f)
+        debug.rect(combined.transformRect(bounds), sf::Color::Green);
+    debug_draw_current(debug, combined);
+    for (const Ptr& child : m_children)
+        child->collect_debug(debug, combined, interpolation);
+}
+
+void SceneNode::debug_draw_current(DebugDraw&, const sf::Transform&) const
+{
+    // do nothing by default
+}
+
+/**
+ * @param float interpolation
+ * Fraction of a tick elapsed since the last update, in [0, 1].
+ * @return Returns the relative transform of the node with its position
+ * interpolated between the previous and current tick. Nodes created this tick
+ * are at their current position.
+ */
+sf::Transform SceneNode::get_interpolated_transform(float interpolation) const
+{
+    if (!m_has_previous_position || interpolation >= 1.f)
+        return getTransform();
+    // move back from the current position, in the parent's coordinates
+    sf::Transform transform;
+    transform.translate((getPosition() - m_previous_position)
+            * (interpolation - 1.f));
+    return transform * getTransform();
+}
+
+/**
+ * @return Empty rect by default, nodes without bounds (layers, scene root) are
+ * never culled.
+ */
+sf::FloatRect SceneNode::get_cull_bounds() const
+{
+    return sf::FloatRect();
+}
+
 // absolute transformation functions ->
 sf::Transform SceneNode::get_world_transform() const
 {
@@ -106,12 +248,13 @@ sf::Vector2f SceneNode::get_world_position() const
 }
 
 /**
- * @return Returns category of scene node.
- * @note Default category is Category::SceneGroundLayer.
+ * @return Returns category of scene node, given on construction.
+ * @note Default category is Category::None, plain nodes (sprites, texts...)
+ * do not receive category commands.
  */
 unsigned int SceneNode::get_category() const
 {
-    return Category::SceneGroundLayer;
+    return m_default_category;
 }
 
 void SceneNode::on_command(const Command& command, sf::Time dt)
@@ -124,27 +267,6 @@ void SceneNode::on_command(const Command& command, sf::Time dt)
         child->on_command(command, dt);
 }
 
-/*
- * Draws the bounding rectangle used for collision detection around sprites.
- * @note Used for debugging, flag used to enable is in Debug class.
- */
-void SceneNode::draw_bounding_rect(sf::RenderTarget& target,
-        sf::RenderStates states) const
-{
-    sf::FloatRect rect = get_bounding_rect();
-
-    sf::RectangleShape shape;
-    shape.setPosition(sf::Vector2(rect.left, rect.top));
-    shape.setSize(sf::Vector2f(rect.width, rect.height));
-    /// Fill color can be made a solid color to have bounding rectangles be
-    /// display as solid color rectangles.
-    shape.setFillColor(sf::Color::Transparent);
-    shape.setOutlineColor(sf::Color::Green);
-    shape.setOutlineThickness(1.f);
-
-    target.draw(shape);
-}
-
 /**
  * Checks the entire scene graph against one node for collisions.
  * @remark O(n^2) complexity, can be optimized.
@@ -181,17 +303,6 @@ void SceneNode::check_scene_collision(SceneNode& scene_graph,
         check_scene_collision(*child, collision_pairs);
 }
 
-/**
- * Mark node for removal, to be handled appropriately.
- * @return Returns true if node is marked to be removed.
- */
-bool SceneNode::is_marked_for_removal() const
-{
-    /// Uses is_destroyed() to determine if marked for removal.
-    return is_destroyed();
-}
-
-
 /// Virtual fn for derived class(es) to implement and handle.
 bool SceneNode::is_destroyed() const
 {
@@ -199,28 +310,6 @@ bool SceneNode::is_destroyed() const
     return false;
 }
 
-/**
- * Removal routine.
- * @if is_marked_for_removal().
- * @return No return value, but creates a fn object for World::update to use
- * to remove nodes that request their removal.
- * @remarks Removal routine allows special routines to be ran before node is
- * formally removed, such as animations, particle effects, etc.
- */
-void SceneNode::removal()
-{
-    /// Rearranges the children container, so that all active nodes are at the
-    /// beginning and all nodes to be removed are at the end.
-    auto removal_begin = std::remove_if(m_children.begin(), m_children.end(),
-            std::mem_fn(&SceneNode::is_marked_for_removal));
-    /// Erases the SceneNode::Ptr objects to be removed.
-    m_children.erase(removal_begin, m_children.end());
-    /// Recursive fn call to create a fn object for each node marked for removal
-    /// - fn object to be used in World::update.
-    std::for_each(m_children.begin(), m_children.end(),
-            std::mem_fn(&SceneNode::removal));
-}
-
 /**
  * @return Returns the bounding rectangle of current scene node.
  */
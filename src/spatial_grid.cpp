@@ -0,0 +1,240 @@
+#include "spatial_grid.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+SpatialGrid::SpatialGrid(const sf::FloatRect& bounds, float cell_size) :
+    m_bounds(bounds),
+    m_cell_size(cell_size),
+    m_columns(std::max(1, static_cast<std::int32_t>(
+                    std::ceil(bounds.width / cell_size)))),
+    m_rows(std::max(1, static_cast<std::int32_t>(
+                    std::ceil(bounds.height / cell_size)))),
+    m_pending(),
+    m_items(),
+    m_cell_start(static_cast<std::size_t>(m_columns * m_rows) + 1, 0),
+    m_cell_next(),
+    m_is_built(true)
+{
+    assert(cell_size > 0.f);
+}
+
+/// Remove all items, keeping capacity for the next rebuild.
+void SpatialGrid::clear()
+{
+    m_pending.clear();
+    m_items.clear();
+    std::fill(m_cell_start.begin(), m_cell_start.end(), 0);
+    m_is_built = true;
+}
+
+/// Index node at position, visible to queries after the next build.
+void SpatialGrid::insert(SceneNode* node, sf::Vector2f position)
+{
+    m_pending.push_back(Item{node, position});
+    m_is_built = false;
+}
+
+/**
+ * Find the nearest node to position within radius.
+ * @return Returns the nearest node, nullptr if none is within radius.
+ * @note Searches cells ring by ring outward, and stops once a ring is further
+ * than the nearest node found.
+ */
+SceneNode* SpatialGrid::query_nearest(sf::Vector2f position, float radius)
+{
+    build();
+    SceneNode* nearest = nullptr;
+    float nearest_sq = radius * radius;
+    std::int32_t column = to_column(position.x);
+    std::int32_t row = to_row(position.y);
+    // rings past the grid are empty
+    std::int32_t max_ring = std::min(
+            static_cast<std::int32_t>(std::ceil(radius / m_cell_size)),
+            std::max(m_columns, m_rows));
+
+    /// Check every item of one cell, keep the nearest.
+    auto search_cell = [&] (std::int32_t x, std::int32_t y) {
+        if (x < 0 || x >= m_columns || y < 0 || y >= m_rows)
+            return;
+        auto cell = static_cast<std::size_t>(y * m_columns + x);
+        for (std::size_t i = m_cell_start[cell]; i < m_cell_start[cell + 1];
+                ++i) {
+            sf::Vector2f offset = m_items[i].position - position;
+            float distance_sq = offset.x * offset.x + offset.y * offset.y;
+            if (distance_sq <= nearest_sq) {
+                nearest_sq = distance_sq;
+                nearest = m_items[i].node;
+            }
+        }
+    };
+
+    for (std::int32_t ring = 0; ring <= max_ring; ++ring) {
+        // everything in this ring is at least (ring - 1) cells away
+        float ring_distance = static_cast<float>(ring - 1) * m_cell_size;
+        if (nearest != nullptr && ring_distance > 0.f
+                && ring_distance * ring_distance > nearest_sq)
+            break;
+        if (ring == 0) {
+            search_cell(column, row);
+            continue;
+        }
+        // only the border of the ring, inside was searched already
+        for (std::int32_t x = column - ring; x <= column + ring; ++x) {
+            search_cell(x, row - ring);
+            search_cell(x, row + ring);
+        }
+        for (std::int32_t y = row - ring + 1; y < row + ring; ++y) {
+            search_cell(column - ring, y);
+            search_cell(column + ring, y);
+        }
+    }
+    return nearest;
+}
+
+/**
+ * Find all nodes within radius of position.
+ * @param std::vector<Item>& items
+ * Nodes found, appended to in no particular order.
+ */
+void SpatialGrid::query_radius(sf::Vector2f position, float radius,
+        std::vector<Item>& items)
+{
+    build();
+    float radius_sq = radius * radius;
+    std::int32_t left = to_column(position.x - radius);
+    std::int32_t right = to_column(position.x + radius);
+    std::int32_t top = to_row(position.y - radius);
+    std::int32_t bottom = to_row(position.y + radius);
+
+    for (std::int32_t y = top; y <= bottom; ++y) {
+        for (std::int32_t x = left; x <= right; ++x) {
+            auto cell = static_cast<std::size_t>(y * m_columns + x);
+            for (std::size_t i = m_cell_start[cell];
+                    i < m_cell_start[cell + 1]; ++i) {
+                sf::Vector2f offset = m_items[i].position - position;
+                if (offset.x * offset.x + offset.y * offset.y <= radius_sq)
+                    items.push_back(m_items[i]);
+            }
+        }
+    }
+}
+
+/**
+ * Find the k nearest nodes within radius of position.
+ * @param std::vector<Item>& items
+ * Nodes found, cleared and filled nearest first.
+ */
+void SpatialGrid::query_k_nearest(sf::Vector2f position, float radius,
+        std::size_t k, std::vector<Item>& items)
+{
+    items.clear();
+    query_radius(position, radius, items);
+    auto distance_sq = [position] (const Item& item) {
+        sf::Vector2f offset = item.position - position;
+        return offset.x * offset.x + offset.y * offset.y;
+    };
+    std::size_t count = std::min(k, items.size());
+    std::partial_sort(items.begin(), items.begin() + count, items.end(),
+            [&] (const Item& lhs, const Item& rhs) {
+                return distance_sq(lhs) < distance_sq(rhs);
+            });
+    items.resize(count);
+}
+
+/**
+ * Find the cells intersecting area with at least one node, e.g. to show the
+ * grid for debugging.
+ * @param std::vector<Cell>& cells
+ * Cells found, cleared and filled row by row.
+ */
+void SpatialGrid::query_occupied_cells(const sf::FloatRect& area,
+        std::vector<Cell>& cells)
+{
+    build();
+    cells.clear();
+    std::int32_t left = to_column(area.left);
+    std::int32_t right = to_column(area.left + area.width);
+    std::int32_t top = to_row(area.top);
+    std::int32_t bottom = to_row(area.top + area.height);
+
+    for (std::int32_t y = top; y <= bottom; ++y) {
+        for (std::int32_t x = left; x <= right; ++x) {
+            auto cell = static_cast<std::size_t>(y * m_columns + x);
+            std::size_t count = m_cell_start[cell + 1] - m_cell_start[cell];
+            if (count == 0)
+                continue;
+            cells.push_back(Cell{sf::FloatRect(
+                        m_bounds.left + static_cast<float>(x) * m_cell_size,
+                        m_bounds.top + static_cast<float>(y) * m_cell_size,
+                        m_cell_size, m_cell_size), count});
+        }
+    }
+}
+
+/**
+ * @return Returns count of indexed nodes.
+ */
+std::size_t SpatialGrid::size() const
+{
+    return m_pending.size();
+}
+
+sf::FloatRect SpatialGrid::get_bounds() const
+{
+    return m_bounds;
+}
+
+float SpatialGrid::get_cell_size() const
+{
+    return m_cell_size;
+}
+
+/**
+ * Counting sort of pending items by cell, no-op if nothing was inserted since
+ * the last build.
+ */
+void SpatialGrid::build()
+{
+    if (m_is_built)
+        return;
+
+    std::fill(m_cell_start.begin(), m_cell_start.end(), 0);
+    /// Count items per cell, offset by one...
+    for (const Item& item : m_pending)
+        ++m_cell_start[to_cell(item.position) + 1];
+    /// ...prefix sum to the first index of each cell...
+    for (std::size_t i = 1; i < m_cell_start.size(); ++i)
+        m_cell_start[i] += m_cell_start[i - 1];
+    /// ...and scatter, using the end of the cell as the next free index.
+    m_items.resize(m_pending.size());
+    m_cell_next.assign(m_cell_start.begin(), m_cell_start.end() - 1);
+    for (const Item& item : m_pending)
+        m_items[m_cell_next[to_cell(item.position)]++] = item;
+
+    m_is_built = true;
+}
+
+std::size_t SpatialGrid::to_cell(sf::Vector2f position) const
+{
+    return static_cast<std::size_t>(to_row(position.y) * m_columns
+            + to_column(position.x));
+}
+
+/// Column of x, clamped to the grid.
+std::int32_t SpatialGrid::to_column(float x) const
+{
+    float column = std::floor((x - m_bounds.left) / m_cell_size);
+    return static_cast<std::int32_t>(std::clamp(column, 0.f,
+                static_cast<float>(m_columns - 1)));
+}
+
+/// Row of y, clamped to the grid.
+std::int32_t SpatialGrid::to_row(float y) const
+{
+    float row = std::floor((y - m_bounds.top) / m_cell_size);
+    return static_cast<std::int32_t>(std::clamp(row, 0.f,
+                static_cast<float>(m_rows - 1)));
+}
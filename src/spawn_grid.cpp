@@ -0,0 +1,87 @@
+#include "spawn_grid.h"
+
+#include <cassert>
+#include <cmath>
+
+SpawnGrid::SpawnGrid(float chunk_size) :
+    m_chunk_size(chunk_size),
+    m_chunks(),
+    m_size(0),
+    m_last_range(),
+    m_is_last_range_valid(false)
+{
+    assert(chunk_size > 0.f);
+}
+
+/**
+ * Insert a spawn point into the chunk containing it.
+ */
+void SpawnGrid::insert(const SpawnPoint& spawn)
+{
+    m_chunks[to_key(to_chunk(spawn.vec2.x), to_chunk(spawn.vec2.y))]
+        .push_back(spawn);
+    ++m_size;
+    /// New spawn point may be in the last range popped.
+    m_is_last_range_valid = false;
+}
+
+/**
+ * Moves all spawn points of the chunks intersecting area into spawns, and
+ * removes those chunks from the grid.
+ * @param const sf::FloatRect& area
+ * The area to activate, e.g. the view bounds plus an activation radius.
+ * @param std::vector<SpawnPoint>& spawns
+ * The spawn points to be spawned, appended to.
+ * @note Only chunks in area are looked up, and if area covers the same chunks
+ * as the last call, nothing is looked up.
+ */
+void SpawnGrid::pop_in(const sf::FloatRect& area,
+        std::vector<SpawnPoint>& spawns)
+{
+    ChunkRange range{to_chunk(area.left), to_chunk(area.top),
+        to_chunk(area.left + area.width), to_chunk(area.top + area.height)};
+    if (m_chunks.empty()
+            || (m_is_last_range_valid && range == m_last_range))
+        return;
+    m_last_range = range;
+    m_is_last_range_valid = true;
+
+    for (std::int32_t y = range.top; y <= range.bottom; ++y) {
+        for (std::int32_t x = range.left; x <= range.right; ++x) {
+            auto found = m_chunks.find(to_key(x, y));
+            if (found == m_chunks.end())
+                continue;
+            spawns.insert(spawns.end(), found->second.begin(),
+                    found->second.end());
+            m_size -= found->second.size();
+            m_chunks.erase(found);
+        }
+    }
+}
+
+/**
+ * @return Returns count of spawn points not yet popped.
+ */
+std::size_t SpawnGrid::size() const
+{
+    return m_size;
+}
+
+/// Check if spawn grid is empty - t/f
+bool SpawnGrid::is_empty() const
+{
+    return m_size == 0;
+}
+
+/// Chunk coordinate of a world coordinate, floored for negative coordinates.
+std::int32_t SpawnGrid::to_chunk(float coord) const
+{
+    return static_cast<std::int32_t>(std::floor(coord / m_chunk_size));
+}
+
+/// Pack chunk coordinates (x, y) into one key.
+std::uint64_t SpawnGrid::to_key(std::int32_t x, std::int32_t y)
+{
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32)
+        | static_cast<std::uint32_t>(y);
+}
@@ -0,0 +1,30 @@
+#include "spawn_queue.h"
+
+#include <utility>
+
+/**
+ * Queue a created node, to be attached on the next flush().
+ */
+void SpawnQueue::push(SceneNode::Ptr node)
+{
+    m_pending.push_back(std::move(node));
+}
+
+/**
+ * Attach all queued nodes to layer, in the order they were created.
+ * @note Keeps capacity for the next tick.
+ */
+void SpawnQueue::flush(SceneNode& layer)
+{
+    for (SceneNode::Ptr& node : m_pending)
+        layer.attach_child(std::move(node));
+    m_pending.clear();
+}
+
+/**
+ * @return Returns the count of nodes waiting to be attached.
+ */
+std::size_t SpawnQueue::get_pending_count() const
+{
+    return m_pending.size();
+}
@@ -0,0 +1,210 @@
+#include "sprite_batch.h"
+#include "draw_list.h"
+
+#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/Graphics/Text.hpp>
+
+SpriteBatch::SpriteBatch() :
+    m_batches(),
+    m_batch_count(0),
+    m_last_batch(0),
+    m_fallbacks(),
+    m_cull_rect(),
+    m_culled_count(0),
+    m_interpolation(1.f)
+{
+}
+
+/**
+ * Empties all batches for the next pass, keeping their capacity.
+ * @note The cull rect is kept, only the culled count is reset.
+ */
+void SpriteBatch::clear()
+{
+    for (std::size_t i = 0; i < m_batch_count; ++i)
+        m_batches[i].vertices.clear();
+    m_batch_count = 0;
+    m_last_batch = 0;
+    m_fallbacks.clear();
+    m_culled_count = 0;
+}
+
+/**
+ * Adds sprite as two triangles to the batch of its texture.
+ * @param const sf::Transform& transform
+ * Absolute transform of the node owning sprite.
+ */
+void SpriteBatch::add(const sf::Sprite& sprite, const sf::Transform& transform)
+{
+    const sf::Texture* texture = sprite.getTexture();
+    if (texture == nullptr)
+        return;
+
+    sf::Transform combined = transform * sprite.getTransform();
+    sf::FloatRect bounds = sprite.getLocalBounds();
+    sf::IntRect rect = sprite.getTextureRect();
+    sf::Color color = sprite.getColor();
+
+    // corners of the quad, in local and texture coordinates
+    float left = static_cast<float>(rect.left);
+    float top = static_cast<float>(rect.top);
+    float right = left + static_cast<float>(rect.width);
+    float bottom = top + static_cast<float>(rect.height);
+    sf::Vertex top_left(combined.transformPoint(0.f, 0.f), color,
+            sf::Vector2f(left, top));
+    sf::Vertex top_right(combined.transformPoint(bounds.width, 0.f), color,
+            sf::Vector2f(right, top));
+    sf::Vertex bottom_right(combined.transformPoint(bounds.width,
+                bounds.height), color, sf::Vector2f(right, bottom));
+    sf::Vertex bottom_left(combined.transformPoint(0.f, bounds.height), color,
+            sf::Vector2f(left, bottom));
+
+    std::vector<sf::Vertex>& vertices = get_batch(texture).vertices;
+    vertices.push_back(top_left);
+    vertices.push_back(top_right);
+    vertices.push_back(bottom_right);
+    vertices.push_back(top_left);
+    vertices.push_back(bottom_right);
+    vertices.push_back(bottom_left);
+}
+
+/**
+ * Adds count vertices of triangles to the batch of texture.
+ * @param const sf::Transform& transform
+ * Absolute transform of the node owning the vertices.
+ */
+void SpriteBatch::add(const sf::Vertex* vertices, std::size_t count,
+        const sf::Texture* texture, const sf::Transform& transform)
+{
+    std::vector<sf::Vertex>& batch = get_batch(texture).vertices;
+    for (std::size_t i = 0; i < count; ++i) {
+        sf::Vertex vertex = vertices[i];
+        vertex.position = transform.transformPoint(vertex.position);
+        batch.push_back(vertex);
+    }
+}
+
+/**
+ * Adds a text, drawn on its own after the batches.
+ * @attention text must outlive the pass.
+ */
+void SpriteBatch::add(const sf::Text& text, const sf::Transform& transform)
+{
+    m_fallbacks.push_back(Fallback{nullptr, &text, transform, nullptr});
+}
+
+/**
+ * Adds a drawable that can not be batched, drawn on its own after the batches.
+ * @param const sf::Texture* texture
+ * Texture set in the render states of drawable, for drawables that do not
+ * carry their own (e.g. sf::VertexBuffer).
+ * @attention drawable must outlive the pass.
+ */
+void SpriteBatch::add(const sf::Drawable& drawable,
+        const sf::Transform& transform, const sf::Texture* texture)
+{
+    m_fallbacks.push_back(Fallback{&drawable, nullptr, transform, texture});
+}
+
+/**
+ * Records each batch as one draw call into frame, then the fallback drawables.
+ * @note Texts are copied into frame, other fallbacks are recorded by
+ * reference and must not change until frame is drawn.
+ */
+void SpriteBatch::draw(DrawList& frame) const
+{
+    for (std::size_t i = 0; i < m_batch_count; ++i) {
+        const Batch& batch = m_batches[i];
+        frame.add(batch.vertices.data(), batch.vertices.size(), batch.texture);
+    }
+    for (const Fallback& fallback : m_fallbacks) {
+        if (fallback.text != nullptr)
+            frame.add(*fallback.text, fallback.transform);
+        else
+            frame.add(*fallback.drawable, fallback.transform,
+                    fallback.texture);
+    }
+}
+
+/**
+ * @return Returns the count of draw calls issued by draw().
+ */
+std::size_t SpriteBatch::get_draw_call_count() const
+{
+    return m_batch_count + m_fallbacks.size();
+}
+
+/// Finds the batch of texture, or starts a new one.
+SpriteBatch::Batch& SpriteBatch::get_batch(const sf::Texture* texture)
+{
+    if (m_last_batch < m_batch_count
+            && m_batches[m_last_batch].texture == texture)
+        return m_batches[m_last_batch];
+    for (std::size_t i = 0; i < m_batch_count; ++i) {
+        if (m_batches[i].texture == texture) {
+            m_last_batch = i;
+            return m_batches[i];
+        }
+    }
+    if (m_batch_count == m_batches.size())
+        m_batches.push_back(Batch{nullptr, {}});
+    m_last_batch = m_batch_count++;
+    m_batches[m_last_batch].texture = texture;
+    return m_batches[m_last_batch];
+}
+
+/**
+ * Sets the absolute area of the pass, usually the view bounds plus a margin.
+ * Pass an empty rect to collect every node.
+ */
+void SpriteBatch::set_cull_rect(const sf::FloatRect& rect)
+{
+    m_cull_rect = rect;
+}
+
+/**
+ * @return Absolute area of the pass, empty if culling is disabled.
+ */
+const sf::FloatRect& SpriteBatch::get_cull_rect() const
+{
+    return m_cull_rect;
+}
+
+/**
+ * Tests absolute bounds of a node against the cull rect, counting culled
+ * nodes.
+ * @return True if the node is outside the cull rect and must be skipped.
+ */
+bool SpriteBatch::cull(const sf::FloatRect& bounds)
+{
+    if (m_cull_rect.width <= 0.f || m_cull_rect.height <= 0.f)
+        return false;
+    if (m_cull_rect.intersects(bounds))
+        return false;
+    ++m_culled_count;
+    return true;
+}
+
+/**
+ * @return Count of nodes culled since clear(), their children are skipped
+ * with them and not counted.
+ */
+std::size_t SpriteBatch::get_culled_count() const
+{
+    return m_culled_count;
+}
+
+/**
+ * Sets the fraction of a tick elapsed since the last update, nodes are
+ * collected at their position interpolated by it.
+ * @see SceneNode::store_previous_positions()
+ */
+void SpriteBatch::set_interpolation(float interpolation)
+{
+    m_interpolation = interpolation;
+}
+
+float SpriteBatch::get_interpolation() const
+{
+    return m_interpolation;
+}
@@ -1,13 +1,16 @@
 #include "sprite_node.h"
+#include "sprite_batch.h"
 
 #include <SFML/Graphics/RenderTarget.hpp>
 
 SpriteNode::SpriteNode(const sf::Texture& texture) :
+    SceneNode(Category::None, NODE_TYPE),
     m_sprite(texture)
 {}
 
 SpriteNode::SpriteNode(const sf::Texture& texture,
         const sf::IntRect& texture_rect) :
+    SceneNode(Category::None, NODE_TYPE),
     m_sprite(texture, texture_rect)
 {}
 
@@ -16,3 +19,9 @@ void SpriteNode::draw_current(sf::RenderTarget& target, sf::RenderStates states)
 {
     target.draw(m_sprite, states);
 }
+
+void SpriteNode::collect_current(SpriteBatch& batch,
+        const sf::Transform& transform) const
+{
+    batch.add(m_sprite, transform);
+}
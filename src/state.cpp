@@ -5,11 +5,12 @@
 #include <SFML/Graphics/Color.hpp>
 
 State::Context::Context(sf::RenderWindow& window, TextureHolder& textures,
-        FontHolder& fonts, Player& player) :
+        FontHolder& fonts, Player& player, RenderThread& render_thread) :
     window(&window),
     textures(&textures),
     fonts(&fonts),
-    player(&player) {}
+    player(&player),
+    render_thread(&render_thread) {}
 
 State::State(StateStack& stack, Context context) :
     m_stack(&stack),
@@ -17,6 +18,8 @@ State::State(StateStack& stack, Context context) :
 
 State::~State() {}
 
+void State::skip_update() {}
+
 /*void State::clear() {
     // get window from context & set view to full window
     Context.window->setView(window->getDefaultView());
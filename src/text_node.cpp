@@ -1,32 +1,201 @@
 #include "text_node.h"
-#include "utility.h"
+#include "sprite_batch.h"
 
 #include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Glyph.hpp>
+#include <SFML/System/String.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <utility>
+
+namespace {
+    /// Characters loaded into a font page on its first use, printable ASCII.
+    constexpr sf::Uint32 FIRST_PRELOADED = U' ';
+    constexpr sf::Uint32 LAST_PRELOADED = U'~';
+    /// Laid out instead of characters outside the preloaded range.
+    constexpr sf::Uint32 REPLACEMENT = U'?';
+}
 
 /**
  * Default constructor sets font of TextNode to parameter, sets font size, and
  * sets text displayed to std::string parameter.
  * */
-TextNode::TextNode(const FontHolder& fonts, const std::string& text)
+TextNode::TextNode(const FontHolder& fonts, const std::string& text) :
+    SceneNode(Category::None, NODE_TYPE),
+    m_font(fonts.get(Fonts::Main)),
+    m_character_size(14),
+    m_string(text),
+    m_vertices()
 {
-    m_text.setFont(fonts.get(Fonts::Main));
-    m_text.setCharacterSize(14);
-    set_string(text);
+    build_geometry();
 }
 
 void TextNode::draw_current(sf::RenderTarget& target, sf::RenderStates states)
     const
 {
-    target.draw(m_text, states);
+    states.texture = &get_glyph_page(m_font, m_character_size);
+    target.draw(m_vertices.data(), m_vertices.size(), sf::Triangles, states);
+}
+
+void TextNode::collect_current(SpriteBatch& batch,
+        const sf::Transform& transform) const
+{
+    // texts of a font page batch together, like sprites of a texture
+    batch.add(m_vertices.data(), m_vertices.size(),
+            &get_glyph_page(m_font, m_character_size), transform);
 }
 
 /**
- * Separate utility fn to both setString() and center_origin() in one fn call.
+ * Sets the text of the TextNode, centered on the node. The glyph quads are
+ * only rebuilt if text differs from the current text.
  * @param const std::string& text
  * The std::string to be set as the text for the TextNode.
  */
 void TextNode::set_string(const std::string& text)
 {
-    m_text.setString(text);
-    center_origin(m_text);
+    if (text == m_string)
+        return;
+    m_string = text;
+    build_geometry();
+}
+
+const std::string& TextNode::get_string() const
+{
+    return m_string;
+}
+
+/**
+ * Builds the glyph quads of m_string, with the origin at their center like
+ * center_origin().
+ * @note Glyphs missing from the font page are loaded here, not when drawing.
+ */
+void TextNode::build_geometry()
+{
+    m_vertices.clear();
+    sf::FloatRect bounds = append_glyph_quads(m_vertices, m_font,
+            m_character_size, m_string);
+    if (m_vertices.empty())
+        return;
+
+    // center on the node, same rounding as center_origin()
+    sf::Vector2f origin(std::floor(bounds.left + bounds.width / 2.f),
+            std::floor(bounds.top + bounds.height / 2.f));
+    for (sf::Vertex& vertex : m_vertices)
+        vertex.position -= origin;
+}
+
+/**
+ * Appends the glyph quads of text to vertices as triangles, laid out like
+ * sf::Text (kerning, whitespace and new lines) from the origin, to be drawn
+ * with get_glyph_page() of character_size.
+ * @note Characters outside printable ASCII are laid out as REPLACEMENT, their
+ * glyphs would have to be loaded into a page the render thread may be
+ * drawing.
+ * @return Returns the bounds of the appended quads.
+ */
+sf::FloatRect append_glyph_quads(std::vector<sf::Vertex>& vertices,
+        const sf::Font& font, unsigned int character_size,
+        const std::string& text, sf::Color color)
+{
+    if (text.empty())
+        return sf::FloatRect();
+    get_glyph_page(font, character_size);
+
+    // glyphs are padded in the font page, include the padding in the quads
+    const float padding = 1.f;
+    const float whitespace_width =
+        font.getGlyph(U' ', character_size, false).advance;
+    const float line_spacing = font.getLineSpacing(character_size);
+    float x = 0.f;
+    float y = static_cast<float>(character_size);
+    float min_x = static_cast<float>(character_size);
+    float min_y = static_cast<float>(character_size);
+    float max_x = 0.f;
+    float max_y = 0.f;
+
+    sf::String string(text);
+    sf::Uint32 previous = 0;
+    for (sf::Uint32 current : string) {
+        if (current == U'\r')
+            continue;
+        if ((current < FIRST_PRELOADED || current > LAST_PRELOADED)
+                && current != U'\n' && current != U'\t')
+            current = REPLACEMENT;
+        x += font.getKerning(previous, current, character_size);
+        previous = current;
+
+        if (current == U' ' || current == U'\n' || current == U'\t') {
+            min_x = std::min(min_x, x);
+            min_y = std::min(min_y, y);
+            if (current == U' ') {
+                x += whitespace_width;
+            } else if (current == U'\t') {
+                x += whitespace_width * 4.f;
+            } else {
+                y += line_spacing;
+                x = 0.f;
+            }
+            max_x = std::max(max_x, x);
+            max_y = std::max(max_y, y);
+            continue;
+        }
+
+        const sf::Glyph& glyph = font.getGlyph(current, character_size, false);
+        float left = x + glyph.bounds.left;
+        float top = y + glyph.bounds.top;
+        float right = left + glyph.bounds.width;
+        float bottom = top + glyph.bounds.height;
+        float u1 = static_cast<float>(glyph.textureRect.left) - padding;
+        float v1 = static_cast<float>(glyph.textureRect.top) - padding;
+        float u2 = static_cast<float>(glyph.textureRect.left
+                + glyph.textureRect.width) + padding;
+        float v2 = static_cast<float>(glyph.textureRect.top
+                + glyph.textureRect.height) + padding;
+
+        sf::Vertex top_left(sf::Vector2f(left - padding, top - padding),
+                color, sf::Vector2f(u1, v1));
+        sf::Vertex top_right(sf::Vector2f(right + padding, top - padding),
+                color, sf::Vector2f(u2, v1));
+        sf::Vertex bottom_right(sf::Vector2f(right + padding,
+                    bottom + padding), color, sf::Vector2f(u2, v2));
+        sf::Vertex bottom_left(sf::Vector2f(left - padding, bottom + padding),
+                color, sf::Vector2f(u1, v2));
+        vertices.push_back(top_left);
+        vertices.push_back(top_right);
+        vertices.push_back(bottom_left);
+        vertices.push_back(bottom_left);
+        vertices.push_back(top_right);
+        vertices.push_back(bottom_right);
+
+        min_x = std::min(min_x, left);
+        min_y = std::min(min_y, top);
+        max_x = std::max(max_x, right);
+        max_y = std::max(max_y, bottom);
+        x += glyph.advance;
+    }
+    return sf::FloatRect(min_x, min_y, max_x - min_x, max_y - min_y);
+}
+
+/**
+ * @return Returns the font page texture of character_size, for glyph quads of
+ * append_glyph_quads(). The printable ASCII glyphs are loaded into the page on
+ * its first use, so drawing the page never races with a glyph load.
+ * @attention Font pages are only loaded and read by the recording thread, the
+ * render thread only binds the returned texture. Texts laid out by sf::Text on
+ * the recording thread must stay within printable ASCII too.
+ * @see DrawList::add(const sf::Text&, const sf::Transform&)
+ */
+const sf::Texture& get_glyph_page(const sf::Font& font,
+        unsigned int character_size)
+{
+    // pages loaded so far, only touched by the recording thread
+    static std::set<std::pair<const sf::Font*, unsigned int>> loaded_pages;
+    if (loaded_pages.emplace(&font, character_size).second) {
+        for (sf::Uint32 character = FIRST_PRELOADED;
+                character <= LAST_PRELOADED; ++character)
+            font.getGlyph(character, character_size, false);
+    }
+    return font.getTexture(character_size);
 }
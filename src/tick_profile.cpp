@@ -0,0 +1,101 @@
+#include "tick_profile.h"
+
+#include <iomanip>
+
+namespace {
+    /// Column names of each TickProfile::Phase, in order.
+    constexpr std::array<const char*, TickProfile::PhaseCount> PHASE_NAMES = {
+        "commands", "collisions", "destructions", "spawns", "scene_update",
+    };
+}
+
+TickProfile::TickProfile() :
+    m_clock(),
+    m_totals(),
+    m_current_tick(sf::Time::Zero),
+    m_max_tick(sf::Time::Zero),
+    m_tick_count(0)
+{}
+
+/// Start timing a phase.
+void TickProfile::begin_phase()
+{
+    m_clock.restart();
+}
+
+/// Stop timing a phase, and add the elapsed time to the phase.
+void TickProfile::end_phase(Phase phase)
+{
+    sf::Time elapsed = m_clock.restart();
+    m_totals[phase] += elapsed;
+    m_current_tick += elapsed;
+}
+
+/// Count the tick, and keep the slowest tick since reset().
+void TickProfile::end_tick()
+{
+    if (m_current_tick > m_max_tick)
+        m_max_tick = m_current_tick;
+    m_current_tick = sf::Time::Zero;
+    ++m_tick_count;
+}
+
+/// Clear all accumulated times, e.g. at the start of a new measurement.
+void TickProfile::reset()
+{
+    m_totals.fill(sf::Time::Zero);
+    m_current_tick = sf::Time::Zero;
+    m_max_tick = sf::Time::Zero;
+    m_tick_count = 0;
+}
+
+std::size_t TickProfile::get_tick_count() const
+{
+    return m_tick_count;
+}
+
+/**
+ * @return Returns the average time spent in phase per tick, sf::Time::Zero if
+ * no ticks were profiled.
+ */
+sf::Time TickProfile::get_average(Phase phase) const
+{
+    if (m_tick_count == 0)
+        return sf::Time::Zero;
+    return m_totals[phase] / static_cast<sf::Int64>(m_tick_count);
+}
+
+/**
+ * @return Returns the average time of a whole tick.
+ */
+sf::Time TickProfile::get_average_tick() const
+{
+    sf::Time total = sf::Time::Zero;
+    for (std::size_t i = 0; i < PhaseCount; ++i)
+        total += get_average(static_cast<Phase>(i));
+    return total;
+}
+
+sf::Time TickProfile::get_max_tick() const
+{
+    return m_max_tick;
+}
+
+/// Print the column names matching print(), tab separated.
+void TickProfile::print_header(std::ostream& out)
+{
+    out << "ticks";
+    for (const char* name : PHASE_NAMES)
+        out << "\t" << name << "_us";
+    out << "\ttick_us\tmax_tick_us";
+}
+
+/// Print the tick count and the average time of each phase in microseconds.
+void TickProfile::print(std::ostream& out) const
+{
+    out << m_tick_count;
+    for (std::size_t i = 0; i < PhaseCount; ++i)
+        out << "\t" << get_average(static_cast<Phase>(i)).asMicroseconds();
+    out << "\t" << get_average_tick().asMicroseconds()
+        << "\t" << m_max_tick.asMicroseconds();
+}
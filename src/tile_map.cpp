@@ -0,0 +1,226 @@
+#include "tile_map.h"
+#include "sprite_batch.h"
+
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/View.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+namespace {
+    /// Vertices of one tile, as two triangles.
+    constexpr std::size_t TILE_VERTICES = 6;
+}
+
+/**
+ * Fills a map of size tiles with fill and bakes all of its chunks.
+ * @param const sf::Texture& tileset
+ * Texture of all tiles, see TileMap. Must outlive the map.
+ * @param sf::Vector2i size
+ * Width and height of the map, in tiles.
+ * @attention Needs an active OpenGL context (the window) for vertex buffers.
+ */
+TileMap::TileMap(const sf::Texture& tileset, sf::Vector2i size,
+        Tiles::ID fill) :
+    SceneNode(Category::None, NODE_TYPE),
+    m_tileset(tileset),
+    m_size(size),
+    m_chunk_count((size.x + Tiles::CHUNK_TILES - 1) / Tiles::CHUNK_TILES,
+            (size.y + Tiles::CHUNK_TILES - 1) / Tiles::CHUNK_TILES),
+    m_tiles(static_cast<std::size_t>(size.x * size.y), fill),
+    m_chunks(static_cast<std::size_t>(m_chunk_count.x * m_chunk_count.y)),
+    m_use_buffers(sf::VertexBuffer::isAvailable())
+{
+    for (int y = 0; y < m_chunk_count.y; ++y)
+        for (int x = 0; x < m_chunk_count.x; ++x)
+            build_chunk(x, y);
+}
+
+/**
+ * Sets the tile at x, y and marks its chunk to be rebuilt on the next update.
+ */
+void TileMap::set_tile(int x, int y, Tiles::ID id)
+{
+    assert(x >= 0 && x < m_size.x && y >= 0 && y < m_size.y);
+    Tiles::ID& tile = m_tiles[static_cast<std::size_t>(y * m_size.x + x)];
+    if (tile == id)
+        return;
+    tile = id;
+    int chunk = (y / Tiles::CHUNK_TILES) * m_chunk_count.x
+        + x / Tiles::CHUNK_TILES;
+    m_chunks[static_cast<std::size_t>(chunk)].dirty = true;
+}
+
+Tiles::ID TileMap::get_tile(int x, int y) const
+{
+    assert(x >= 0 && x < m_size.x && y >= 0 && y < m_size.y);
+    return m_tiles[static_cast<std::size_t>(y * m_size.x + x)];
+}
+
+/**
+ * @return Width and height of the map, in tiles.
+ */
+sf::Vector2i TileMap::get_size() const
+{
+    return m_size;
+}
+
+/**
+ * Rebuilds the chunks changed since the last update.
+ */
+void TileMap::update_current(sf::Time, CommandQueue&)
+{
+    rebuild_dirty_chunks();
+}
+
+/**
+ * Rebuilds the chunks changed by set_tile() since the last rebuild.
+ * @note Called by update, or before drawing the map into a cache.
+ */
+void TileMap::rebuild_dirty_chunks()
+{
+    for (int y = 0; y < m_chunk_count.y; ++y)
+        for (int x = 0; x < m_chunk_count.x; ++x)
+            if (m_chunks[static_cast<std::size_t>(y * m_chunk_count.x + x)]
+                    .dirty)
+                build_chunk(x, y);
+}
+
+/**
+ * Draws the chunks in the view of target, for drawing outside of a SpriteBatch.
+ */
+void TileMap::draw_current(sf::RenderTarget& target, sf::RenderStates states)
+    const
+{
+    const sf::View& view = target.getView();
+    sf::FloatRect view_bounds(view.getCenter() - view.getSize() / 2.f,
+            view.getSize());
+    sf::IntRect range = get_chunk_range(
+            states.transform.getInverse().transformRect(view_bounds));
+
+    states.texture = &m_tileset;
+    for (int y = range.top; y < range.top + range.height; ++y) {
+        for (int x = range.left; x < range.left + range.width; ++x) {
+            const Chunk& chunk =
+                m_chunks[static_cast<std::size_t>(y * m_chunk_count.x + x)];
+            if (m_use_buffers)
+                target.draw(chunk.buffer, states);
+            else
+                target.draw(chunk.vertices.data(), chunk.vertices.size(),
+                        sf::Triangles, states);
+        }
+    }
+}
+
+/**
+ * Adds the chunks in the cull rect of batch, each drawn with one draw call.
+ * @note Without vertex buffers, the quads of the chunks are batched instead.
+ */
+void TileMap::collect_current(SpriteBatch& batch,
+        const sf::Transform& transform) const
+{
+    const sf::FloatRect& cull_rect = batch.get_cull_rect();
+    sf::IntRect range(0, 0, m_chunk_count.x, m_chunk_count.y);
+    if (cull_rect.width > 0.f && cull_rect.height > 0.f)
+        range = get_chunk_range(
+                transform.getInverse().transformRect(cull_rect));
+
+    for (int y = range.top; y < range.top + range.height; ++y) {
+        for (int x = range.left; x < range.left + range.width; ++x) {
+            const Chunk& chunk =
+                m_chunks[static_cast<std::size_t>(y * m_chunk_count.x + x)];
+            if (m_use_buffers)
+                batch.add(chunk.buffer, transform, &m_tileset);
+            else
+                batch.add(chunk.vertices.data(), chunk.vertices.size(),
+                        &m_tileset, transform);
+        }
+    }
+}
+
+/**
+ * Bakes the tiles of the chunk at chunk_x, chunk_y into its vertices, and
+ * uploads them to its vertex buffer.
+ */
+void TileMap::build_chunk(int chunk_x, int chunk_y)
+{
+    Chunk& chunk =
+        m_chunks[static_cast<std::size_t>(chunk_y * m_chunk_count.x + chunk_x)];
+    int first_x = chunk_x * Tiles::CHUNK_TILES;
+    int first_y = chunk_y * Tiles::CHUNK_TILES;
+    int last_x = std::min(first_x + Tiles::CHUNK_TILES, m_size.x);
+    int last_y = std::min(first_y + Tiles::CHUNK_TILES, m_size.y);
+    int tileset_columns = std::max(1, static_cast<int>(m_tileset.getSize().x)
+            / Tiles::TILE_WIDTH);
+
+    chunk.vertices.clear();
+    chunk.vertices.reserve(static_cast<std::size_t>(
+                (last_x - first_x) * (last_y - first_y)) * TILE_VERTICES);
+    for (int y = first_y; y < last_y; ++y) {
+        for (int x = first_x; x < last_x; ++x) {
+            int id = m_tiles[static_cast<std::size_t>(y * m_size.x + x)];
+            // corners of the quad, in map and tileset coordinates
+            float left = static_cast<float>(x * Tiles::TILE_WIDTH);
+            float top = static_cast<float>(y * Tiles::TILE_HEIGHT);
+            float right = left + Tiles::TILE_WIDTH;
+            float bottom = top + Tiles::TILE_HEIGHT;
+            float tex_left = static_cast<float>(
+                    (id % tileset_columns) * Tiles::TILE_WIDTH);
+            float tex_top = static_cast<float>(
+                    (id / tileset_columns) * Tiles::TILE_HEIGHT);
+            float tex_right = tex_left + Tiles::TILE_WIDTH;
+            float tex_bottom = tex_top + Tiles::TILE_HEIGHT;
+
+            sf::Vertex top_left(sf::Vector2f(left, top),
+                    sf::Vector2f(tex_left, tex_top));
+            sf::Vertex top_right(sf::Vector2f(right, top),
+                    sf::Vector2f(tex_right, tex_top));
+            sf::Vertex bottom_right(sf::Vector2f(right, bottom),
+                    sf::Vector2f(tex_right, tex_bottom));
+            sf::Vertex bottom_left(sf::Vector2f(left, bottom),
+                    sf::Vector2f(tex_left, tex_bottom));
+            chunk.vertices.push_back(top_left);
+            chunk.vertices.push_back(top_right);
+            chunk.vertices.push_back(bottom_right);
+            chunk.vertices.push_back(top_left);
+            chunk.vertices.push_back(bottom_right);
+            chunk.vertices.push_back(bottom_left);
+        }
+    }
+
+    if (m_use_buffers) {
+        // tiles rarely change, keep the chunk in static GPU memory
+        if (chunk.buffer.getVertexCount() != chunk.vertices.size()) {
+            chunk.buffer.setPrimitiveType(sf::Triangles);
+            chunk.buffer.setUsage(sf::VertexBuffer::Static);
+            chunk.buffer.create(chunk.vertices.size());
+        }
+        chunk.buffer.update(chunk.vertices.data());
+    }
+    chunk.dirty = false;
+}
+
+/**
+ * @return Returns the chunks intersecting area, in map coordinates, as a
+ * range of chunk indices (left, top, width, height).
+ */
+sf::IntRect TileMap::get_chunk_range(const sf::FloatRect& area) const
+{
+    const float chunk_width =
+        static_cast<float>(Tiles::CHUNK_TILES * Tiles::TILE_WIDTH);
+    const float chunk_height =
+        static_cast<float>(Tiles::CHUNK_TILES * Tiles::TILE_HEIGHT);
+    int left = std::clamp(static_cast<int>(area.left / chunk_width), 0,
+            m_chunk_count.x);
+    int top = std::clamp(static_cast<int>(area.top / chunk_height), 0,
+            m_chunk_count.y);
+    int right = std::clamp(
+            static_cast<int>((area.left + area.width) / chunk_width) + 1, 0,
+            m_chunk_count.x);
+    int bottom = std::clamp(
+            static_cast<int>((area.top + area.height) / chunk_height) + 1, 0,
+            m_chunk_count.y);
+    return sf::IntRect(left, top, std::max(0, right - left),
+            std::max(0, bottom - top));
+}
@@ -15,15 +15,10 @@
 
 /// Anonymous namespace to create local random engine to be used.
 namespace {
-    std::default_random_engine create_random_engine()
-    {
-        /// Create seed based on current std::time.
-        auto seed = static_cast<unsigned long>(std::time(nullptr));
-        /// Use std::default_random_engine based on seed.
-        return std::default_random_engine(seed);
-    }
+    /// Create seed based on current std::time.
+    unsigned long RandomSeed = static_cast<unsigned long>(std::time(nullptr));
     /// RandomEngine is interface to use random engine.
-    auto RandomEngine = create_random_engine();
+    std::default_random_engine RandomEngine(RandomSeed);
 }
 
 void center_origin(sf::Sprite& sprite)
@@ -118,6 +113,22 @@ int random_int(int exclusive_max)
     return distr(RandomEngine);
 }
 
+/**
+ * Reseeds the random engine, to replay a recorded session.
+ * @see get_random_seed()
+ */
+void seed_random_engine(unsigned long seed)
+{
+    RandomSeed = seed;
+    RandomEngine.seed(seed);
+}
+
+/// Returns the seed of the random engine, to be recorded.
+unsigned long get_random_seed()
+{
+    return RandomSeed;
+}
+
 /// Returns float length of a float Vector2.
 float length(sf::Vector2f vec2)
 {
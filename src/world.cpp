@@ -1,4 +1,6 @@
 #include <world.h>
+#include "utility.h"
+#include "draw_list.h"
 
 #include <SFML/Graphics/RenderWindow.hpp>
 
@@ -6,6 +8,24 @@
 #include <cmath>
 #include <iostream>
 #include <iomanip>
+#include <string>
+
+namespace {
+    /// Size of a world chunk, spawn points are indexed per chunk.
+    constexpr float CHUNK_SIZE = 512.f;
+    /// Distance from the view bounds at which chunks are activated.
+    constexpr float ACTIVATION_RADIUS = 1000.f;
+    /// Cell size of the enemy index, about the guide range of projectiles.
+    constexpr float ENEMY_INDEX_CELL_SIZE = 128.f;
+    /// Size of the contact marks of the debug overlay, in screen px.
+    constexpr float DEBUG_CONTACT_SIZE = 6.f;
+    /// Distance from the view bounds within which nodes are still drawn, so
+    /// children sticking out of their parent's bounds (e.g. health texts) do
+    /// not pop at the edges.
+    constexpr float CULL_MARGIN = 32.f;
+    /// Slots of the remote command queue, must be a power of two.
+    constexpr std::size_t REMOTE_COMMAND_CAPACITY = 1024;
+}
 
 World::World(sf::RenderWindow& window, FontHolder& fonts) :
     // initialize all parts of the world correctly
@@ -17,12 +37,21 @@ World::World(sf::RenderWindow& window, FontHolder& fonts) :
     m_fonts(fonts),
     m_scene_graph(),
     m_scene_layers(),
+    m_layer_caches(),
+    m_tile_map(nullptr),
+    m_command_queue(),
+    m_tick(0),
+    m_remote_commands(REMOTE_COMMAND_CAPACITY),
+    m_events(),
+    m_effects(),
+    m_score(0),
 
     // world third ->
     // set the size of the world
     m_world_bounds(0.f, 0.f, 5000.f, 5000.f),
     // set player view to be zoomed in, keeping aspect ratio
     m_world_view(sf::FloatRect(0.f, 0.f, 480.f, 270.f)),
+    m_previous_view_center(),
     m_scroll_speed(0.f),
 
     // player fourth ->
@@ -32,18 +61,43 @@ World::World(sf::RenderWindow& window, FontHolder& fonts) :
             m_world_bounds.height / 2.f),
 
     // npcs fifth ->
-    m_npc_spawn_points(),
-    m_active_npcs()
+    m_npc_spawn_grid(CHUNK_SIZE),
+    m_npc_spawns(),
+    m_active_npcs(),
+    m_horde(),
+    m_horde_creatures(),
+    m_horde_projectiles(),
+    m_tick_profile(),
+    m_enemy_index(m_world_bounds, ENEMY_INDEX_CELL_SIZE),
+    m_sprite_batch(),
+    m_culled_count(0),
+    m_debug_draw(fonts.get(Fonts::Main)),
+    m_debug_contacts(),
+    m_debug_cells()
 {
+        /// Entities destroyed in the world are pushed into m_destructions.
+        m_entity_context.destructions = &m_destructions;
+        /// Entities given the context are registered in m_entity_registry.
+        m_entity_context.registry = &m_entity_registry;
+        /// Entities spawned in the world are pushed into m_spawns.
+        m_entity_context.spawns = &m_spawns;
+        /// Entities publish gameplay events into m_events.
+        m_entity_context.events = &m_events;
+        subscribe_events();
+
         load_textures();
         build_scene();
 
         /// Prepare the view - set center to player spawn point.
         m_world_view.setCenter(m_player_spawn_point);
+        m_previous_view_center = m_world_view.getCenter();
 }
 
 void World::update(sf::Time delta_time)
 {
+    /// Drawing interpolates from the positions at the start of the tick.
+    store_previous_positions();
+
     m_world_view.move(0.f, m_scroll_speed * delta_time.asSeconds());
     m_player_creature->set_velocity(0.f, 0.f);
 
@@ -51,30 +105,183 @@ void World::update(sf::Time delta_time)
      * @warning NOT USED. */
     //destroy_entities_outside_chunk();
 
+    /** @brief Commands of other threads are queued behind the commands pushed
+     * on this thread since the last tick. */
+    m_tick_profile.begin_phase();
+    drain_remote_commands();
+
+    /** @brief Setup commands to guide projectiles torwards enemies. */
+    guide_projectiles();
+
     /** @brief Forward commands to the scene graph and adapt player velocity
-     * correctly. */
-    while (!m_command_queue.is_empty())
-        m_scene_graph.on_command(m_command_queue.pop(), delta_time);
+     * correctly. Commands are drained at once and executed in place. */
+    for (const Command& command : m_command_queue.drain())
+        dispatch_command(command, delta_time);
     adapt_player_velocity();
+    m_tick_profile.end_phase(TickProfile::Commands);
 
     /// Constantly update collision detection and response (WARNING: May destroy
-    /// entities).
+    /// entities). Events published by collisions are resolved in batches.
     handle_collisions();
-
-    /// Remove all destroyed entities and create new ones.
-    m_scene_graph.removal();
+    m_events.dispatch<Events::Damage>();
+    m_events.dispatch<Events::PickupCollected>();
+    m_tick_profile.end_phase(TickProfile::Collisions);
+
+    /// Run death effects of, and reclaim, entities destroyed this tick (or
+    /// earlier, if they have a death effect), then create new ones. Entities
+    /// spawned by entities this tick are attached here, outside any traversal.
+    m_destructions.update(delta_time, m_command_queue);
+    m_events.dispatch<Events::CreatureDied>();
+    m_tick_profile.end_phase(TickProfile::Destructions);
     spawn_npcs();
+    if (m_horde)
+        update_horde(delta_time);
+    m_spawns.flush(*m_scene_layers[Foreground]);
+    m_tick_profile.end_phase(TickProfile::Spawns);
 
     /// Regular game update step, adapt player position (correct even though
     /// outside view, because adapt_player_position() handles appropriately).
     m_scene_graph.update(delta_time, m_command_queue);
     adapt_player_position();
+    m_tick_profile.end_phase(TickProfile::SceneUpdate);
+    m_tick_profile.end_tick();
+    ++m_tick;
+
+    if (m_horde && m_horde->is_level_over())
+        report_horde_level();
+}
+
+/**
+ * Stores the current positions of the view and the nodes as the ones drawing
+ * interpolates from, at the start of every tick. While the world is not
+ * updated (e.g. paused) calling it holds the drawing still, instead of
+ * interpolating the last tick over again every frame.
+ */
+void World::store_previous_positions()
+{
+    m_previous_view_center = m_world_view.getCenter();
+    m_scene_graph.store_previous_positions();
+}
+
+/**
+ * Records the scene graph into frame layer by layer, each layer collected into
+ * m_sprite_batch and drawn with one draw call per texture. Static layers are
+ * drawn from their LayerCache instead.
+ * @note Nodes outside the view bounds, offset by CULL_MARGIN, are not
+ * collected, see get_culled_count().
+ * @note Nodes and the view are drawn between their previous and current
+ * tick, by the interpolation of frame, so that ticks slower than the display
+ * rate still move smoothly.
+ */
+void World::draw(DrawList& frame)
+{
+    float interpolation = frame.get_interpolation();
+    sf::View view(m_world_view);
+    view.setCenter(m_previous_view_center + (m_world_view.getCenter()
+                - m_previous_view_center) * interpolation);
+
+    sf::FloatRect cull_rect(view.getCenter() - view.getSize() / 2.f,
+            view.getSize());
+    cull_rect.left -= CULL_MARGIN;
+    cull_rect.top -= CULL_MARGIN;
+    cull_rect.width += 2.f * CULL_MARGIN;
+    cull_rect.height += 2.f * CULL_MARGIN;
+
+    frame.set_view(view);
+    m_sprite_batch.set_cull_rect(cull_rect);
+    m_sprite_batch.set_interpolation(interpolation);
+    m_culled_count = 0;
+    /// Tiles set since the last update are cached as they are now.
+    m_tile_map->rebuild_dirty_chunks();
+    for (std::size_t i = 0; i < LayerCount; ++i) {
+        SceneNode* layer = m_scene_layers[i];
+        if (m_layer_caches[i]
+                && m_layer_caches[i]->collect(*layer, frame, cull_rect))
+            continue;
+        m_sprite_batch.clear();
+        layer->collect(m_sprite_batch, m_scene_graph.getTransform());
+        m_culled_count += m_sprite_batch.get_culled_count();
+        m_sprite_batch.draw(frame);
+    }
+    if (m_debug_draw.is_enabled())
+        draw_debug(frame, view, interpolation);
+}
+
+/**
+ * Records the debug overlay into frame, over the layers: occupied cells of the
+ * enemy index (yellow, with their count), entity bounds (green) and paths
+ * (cyan), contacts of the last tick (red) and frame statistics.
+ * @note Collected here, outside update(), and drawn as one batch, so the tick
+ * profile and the draw call count stay close to those of the scene alone.
+ */
+void World::draw_debug(DrawList& frame, const sf::View& view,
+        float interpolation)
+{
+    float window_width = static_cast<float>(
+            std::max(m_window.getSize().x, 1u));
+    float pixel_size = view.getSize().x / window_width;
+    sf::FloatRect view_bounds(view.getCenter() - view.getSize() / 2.f,
+            view.getSize());
+    m_debug_draw.clear();
+    m_debug_draw.set_pixel_size(pixel_size);
+
+    m_enemy_index.query_occupied_cells(view_bounds, m_debug_cells);
+    for (const SpatialGrid::Cell& cell : m_debug_cells) {
+        m_debug_draw.rect(cell.bounds, sf::Color::Yellow);
+        m_debug_draw.text(sf::Vector2f(cell.bounds.left, cell.bounds.top)
+                + sf::Vector2f(2.f, 2.f) * pixel_size,
+                std::to_string(cell.count), sf::Color::Yellow);
+    }
+
+    m_scene_layers[Foreground]->collect_debug(m_debug_draw,
+            m_scene_graph.getTransform(), interpolation);
+
+    for (const auto& [first, second] : m_debug_contacts) {
+        m_debug_draw.line(first, second, sf::Color::Red);
+        m_debug_draw.cross((first + second) / 2.f,
+                DEBUG_CONTACT_SIZE * pixel_size, sf::Color::Red);
+    }
+
+    m_debug_draw.text(sf::Vector2f(view_bounds.left, view_bounds.top)
+            + sf::Vector2f(4.f, 4.f) * pixel_size,
+            "tick " + std::to_string(m_tick)
+            + "\nentities " + std::to_string(m_entity_registry.size())
+            + "\nculled " + std::to_string(m_culled_count)
+            + "\ncontacts " + std::to_string(m_debug_contacts.size()));
+    m_debug_draw.draw(frame);
+}
+
+/**
+ * Sets the background tile at x, y (in tiles), invalidating its cached area.
+ * @note The tile map is rebuilt in the next update or draw().
+ */
+void World::set_tile(int x, int y, Tiles::ID id)
+{
+    m_tile_map->set_tile(x, y, id);
+    m_layer_caches[Background]->invalidate(m_tile_map->getTransform()
+            .transformRect(sf::FloatRect(
+                    static_cast<float>(x * Tiles::TILE_WIDTH),
+                    static_cast<float>(y * Tiles::TILE_HEIGHT),
+                    static_cast<float>(Tiles::TILE_WIDTH),
+                    static_cast<float>(Tiles::TILE_HEIGHT))));
+}
+
+/**
+ * @return Returns the debug overlay, disabled until toggled (e.g. by
+ * GameState).
+ */
+DebugDraw& World::get_debug_draw()
+{
+    return m_debug_draw;
 }
 
-void World::draw()
+/**
+ * @return Count of nodes culled by the last draw(), children of culled nodes
+ * are not counted.
+ */
+std::size_t World::get_culled_count() const
 {
-    m_window.setView(m_world_view);
-    m_window.draw(m_scene_graph);
+    return m_culled_count;
 }
 
 /**
@@ -86,45 +293,109 @@ CommandQueue& World::get_command_queue()
     return m_command_queue;
 }
 
+/**
+ * @return Returns the count of completed updates, commands pushed now are
+ * executed in this tick.
+ */
+std::uint32_t World::get_tick() const
+{
+    return m_tick;
+}
+
+/**
+ * @return Returns the handle of the player creature, to address player
+ * commands to.
+ */
+EntityHandle World::get_player_handle() const
+{
+    return m_player_creature->get_handle();
+}
+
+/**
+ * Queue for threads other than the simulation thread to push commands into.
+ * @attention Pushes fail (and are counted) when the queue is full, see
+ * drain_remote_commands().
+ */
+ConcurrentCommandQueue& World::get_remote_command_queue()
+{
+    return m_remote_commands;
+}
+
+/**
+ * Start horde stress mode, creatures and projectiles are spawned around the
+ * player level by level, and each level's tick cost is reported.
+ * @see Horde, HordeConfig.
+ */
+void World::start_horde(const HordeConfig& config)
+{
+    m_horde.reset(new Horde(config));
+    m_tick_profile.reset();
+
+    /// Report goes to std::clog, so it stays readable with stdout discarded.
+    std::clog << "level\tpopulation\t";
+    TickProfile::print_header(std::clog);
+    std::clog << std::endl;
+}
+
+/// Check if horde stress mode is over (or was never started) - t/f
+bool World::is_horde_finished() const
+{
+    return !m_horde || m_horde->is_finished();
+}
+
 void World::load_textures()
 {
+    /// Grass is repeated across background tiles, it stays a standalone
+    /// texture.
     m_textures.load(Textures::Grass, "textures/world/grass1.png");
 
-    m_textures.load(Textures::Player, "textures/player/player.png");
-    m_textures.load(Textures::FireProjectile, "textures/player/player.png");
+    /// Entity textures are packed into atlas pages, so entities batch together.
+    m_textures.load_region(Textures::Player, "textures/player/player.png");
+    m_textures.load_region(Textures::FireProjectile,
+            "textures/player/player.png");
 
-    m_textures.load(Textures::Bunny, "textures/player/player.png");
-    m_textures.load(Textures::Bear, "textures/player/player.png");
+    m_textures.load_region(Textures::Bunny, "textures/player/player.png");
+    m_textures.load_region(Textures::Bear, "textures/player/player.png");
 
-    m_textures.load(Textures::HealthRefill, "textures/player/player.png");
+    m_textures.load_region(Textures::HealthRefill,
+            "textures/player/player.png");
+    m_textures.build_atlas();
 }
 
 void World::build_scene()
 {
     /// Initialize all the different scene layers.
     for(std::size_t i = 0; i < LayerCount; ++i) {
-        SceneNode::Ptr layer(new SceneNode());
+        SceneNode::Ptr layer(new SceneNode(Category::SceneGroundLayer));
         m_scene_layers[i] = layer.get();
 
         m_scene_graph.attach_child(std::move(layer));
     }
 
-    // Prepare tiled background.
+    // Prepare tiled background, grass is repeated across each tile.
     sf::Texture& texture = m_textures.get(Textures::Grass);
-    sf::IntRect texture_rect(m_world_bounds);
     texture.setRepeated(true);
 
-    // Add background sprite to the scene.
-    std::unique_ptr<SpriteNode> background_sprite(new SpriteNode(
-                texture, texture_rect));
-    background_sprite->setPosition(m_world_bounds.left, m_world_bounds.top);
-    m_scene_layers[Background]->attach_child(std::move(background_sprite));
+    // Add background tile map covering the world to the scene.
+    sf::Vector2i map_size(
+            static_cast<int>(std::ceil(m_world_bounds.width
+                    / Tiles::TILE_WIDTH)),
+            static_cast<int>(std::ceil(m_world_bounds.height
+                    / Tiles::TILE_HEIGHT)));
+    std::unique_ptr<TileMap> background(new TileMap(texture, map_size,
+                Tiles::Grass));
+    background->setPosition(m_world_bounds.left, m_world_bounds.top);
+    m_tile_map = background.get();
+    m_scene_layers[Background]->attach_child(std::move(background));
+    /// Background only changes through set_tile(), draw it from a cache.
+    m_layer_caches[Background].reset(new LayerCache(m_world_bounds));
 
     // Add player character to the scene.
     std::unique_ptr<Creature> player(new Creature(
                 Creature::Player, m_textures, m_fonts));
     m_player_creature = player.get();
     m_player_creature->setPosition(m_player_spawn_point);
+    m_player_creature->set_context(&m_entity_context);
     m_scene_layers[Foreground]->attach_child(std::move(player));
 
     /// Add NPCs to the scene.
@@ -167,95 +438,92 @@ void World::adapt_player_position()
 	m_player_creature->setPosition(position);
 
     // uncomment to print current player pos
-    std::cout << "Player position: (" << position.x << ", " << position.y << ")\n";
+    //std::cout << "Player position: (" << position.x << ", " << position.y << ")\n";
 }
 
 void World::adapt_player_velocity()
 {
-    sf::Vector2f velocity = m_player_creature->get_velocity();
-
-    // if moving diagonally, reduce velocity (to always have same velocity)
-    if (velocity.x != 0.f && velocity.y != 0.f)
-        m_player_creature->set_velocity(velocity / std::sqrt(2.f));
-
     // add scrolling velocity
     m_player_creature->accelerate(0.f, m_scroll_speed);
 }
 
 /**
- * Spawns NPCs from m_npc_spawn_points.
+ * Spawns NPCs from m_npc_spawn_grid, whose chunk entered the activation radius
+ * around the view.
  * @see add_npcs().
- * @note Assumes m_npc_spawn_points is sorted in ascending order. Iterating
- * from lowest to highest coordinates is more likely to be the common case.
+ * @note Cost is O(nearby chunks), regardless of how many spawn points the world
+ * holds.
  */
 void World::spawn_npcs()
 {
-    /** @todo Decide on whether to implement world chunks or not.
-    // if there's avail spawn points...
-    if (!m_npc_spawn_points.empty()) {
-        // iter through spawn points until at current world chunk (...lowest
-        // coord are more likely to be the common case)
-        for (auto iter = m_npc_spawn_points.begin();
-                iter != m_npc_spawn_points.end(); ++iter) {
-            // if spawn points are within current world chunk...
-            MATH: spawn.x > chunk.left
-            && spawn.x < (chunk.left + chunk.size.x)
-            && spawn.y < chunk.top
-            && spawn.y > (chunk.top - chunk.size.y)
-            if (iter->x > get_chunk_bounds().left
-                    && iter->x < (get_chunk_bounds().left
-                        + get_chunk_bounds().getSize().x)
-                    && iter->y < get_chunk_bounds().top
-                    && iter->y > (get_chunk_bounds().top
-                        - get_chunk_bounds().getSize().y)) {
-                // ... spawn & del from vec...
-                // init SpawnPoint after check to not create unneccesary structs
-                SpawnPoint spawn = *iter;
-                // create smart ptr to npc spawn on heap
-                std::unique_ptr<Creature> npc(
-                        new Creature(spawn.type, m_textures, m_fonts));
-                std::cout << spawn.type << " spawned in the world!"
-                    << std::endl;
-                // set enemy pos to spawn pos
-                npc->setPosition(spawn.x, spawn.y);
-                // bind to foreground layer
-                m_scene_layers[Foreground]->attach_child(std::move(npc));
-                // remove spawn point from vec & keep iter for valid spawns
-                iter = m_npc_spawn_points.erase(iter);
-            }
-            // TODO: break out of loop when spawn point > chunk to not do
-            // unneccesary iter
-        }
+    // pop spawn points of every chunk around the view
+    m_npc_spawn_grid.pop_in(get_chunk_bounds(), m_npc_spawns);
+    for (const SpawnPoint& spawn : m_npc_spawns) {
+        spawn_npc(spawn);
+        // uncomment to print success and pos for confirmation
+        //std::cout << spawn.type << " spawned in the world!" << " ("
+        //    << std::setprecision(0) << spawn.vec2.x << ", " << spawn.vec2.y
+        //    << ")\n";
     }
-    */
-    // if npc spawn points vector is not empty...
-    if (!m_npc_spawn_points.empty()) {
-        // iter through each spawn point and spawn
-        for (auto iter = m_npc_spawn_points.rbegin();
-                iter != m_npc_spawn_points.rend(); ++iter) {
-            // init SpawnPoint AFTER check to not create unneccesary structs
-            SpawnPoint spawn = *iter;
-            // create smart ptr to spawn npc on heap
-            std::unique_ptr<Creature> npc(
-                    new Creature(spawn.type, m_textures, m_fonts));
-            // set enemy pos to spawn pos
-            npc->setPosition(spawn.vec2.x, spawn.vec2.y);
-            // print success and pos for confirmation
-            std::cout << spawn.type << " spawned in the world!" << " ("
-                << std::setprecision(0) << spawn.vec2.x << ", " << spawn.vec2.y
-                << ")\n";
-
-            // bind to foreground layer
-            m_scene_layers[Foreground]->attach_child(std::move(npc));
-            // riter, so pop_back end and "increment" backwards (moving to begin
-            // until vector is empty and all spawn points have been spawned)
-            m_npc_spawn_points.pop_back();
-        }
+    m_npc_spawns.clear();
+}
+
+/**
+ * Spawn ONE NPC into the foreground layer.
+ * @see spawn_npcs(), update_horde().
+ */
+void World::spawn_npc(const SpawnPoint& spawn)
+{
+    // create smart ptr to spawn npc on heap
+    std::unique_ptr<Creature> npc(
+            new Creature(spawn.type, m_textures, m_fonts));
+    // set enemy pos to spawn pos
+    npc->setPosition(spawn.vec2.x, spawn.vec2.y);
+    npc->set_context(&m_entity_context);
+    // bind to foreground layer
+    m_scene_layers[Foreground]->attach_child(std::move(npc));
+}
+
+/**
+ * Spawn this tick's horde creatures, and fire this tick's horde projectiles at
+ * the player.
+ */
+void World::update_horde(sf::Time dt)
+{
+    sf::Vector2f target = m_player_creature->getPosition();
+    m_horde->update(dt, target, m_horde_creatures, m_horde_projectiles);
+
+    for (const SpawnPoint& spawn : m_horde_creatures)
+        spawn_npc(spawn);
+    m_horde_creatures.clear();
+
+    for (const sf::Vector2f& position : m_horde_projectiles) {
+        std::unique_ptr<Projectile> projectile(
+                new Projectile(Projectile::EnemyFire, m_textures));
+        projectile->setPosition(position);
+        projectile->set_velocity(unit_vector(target - position)
+                * projectile->get_max_speed());
+        projectile->set_context(&m_entity_context);
+        m_scene_layers[Foreground]->attach_child(std::move(projectile));
     }
+    m_horde_projectiles.clear();
+}
+
+/**
+ * Print the tick cost of the horde level that just ended, and the population
+ * (entities in the foreground layer) it ended with.
+ */
+void World::report_horde_level()
+{
+    std::clog << m_horde->get_level() << "\t"
+        << m_scene_layers[Foreground]->get_child_count() << "\t";
+    m_tick_profile.print(std::clog);
+    std::clog << std::endl;
+    m_tick_profile.reset();
 }
 
 /**
- * Adds ONE NPC at a time to m_npc_spawn_points.
+ * Adds ONE NPC at a time to m_npc_spawn_grid.
  * @param Creature::Type type
  * The type of the Creature to be added.
  * @param const sf::Vector2& vec2_rel
@@ -270,18 +538,14 @@ void World::add_npc(Creature::Type type, sf::Vector2f& vec2_rel)
     // spawn with enemy type, spawn pos + player pos -> to spawn rel to player
     sf::Vector2f rel{m_player_spawn_point.x + vec2_rel.x,
         m_player_spawn_point.y + vec2_rel.y};
-    SpawnPoint spawn(type, rel);
-    // after init spawn with enemy type and pos of spawn, push into spawn point
-    // vec
-    m_npc_spawn_points.push_back(spawn);
-    std::cout << spawn.type << " added to NPC spawn points" << std::endl;
+    // after init spawn with enemy type and pos of spawn, index into spawn grid
+    m_npc_spawn_grid.insert(SpawnPoint(type, rel));
 }
 
 /**
- * Adds ALL NPCs to be spawned to m_npc_spawn_points.
- * @note Uses add_npc() abstraction to add NPCs to m_npc_spawn_points.
+ * Adds ALL NPCs to be spawned to m_npc_spawn_grid.
+ * @note Uses add_npc() abstraction to add NPCs to m_npc_spawn_grid.
  * @see add_npc().
- * @note Sorts NPCs in descending order, based on y-axis.
  * @remark Does NOT SPAWN NPCs.
  * @see spawn_npcs().
  */
@@ -291,13 +555,6 @@ void World::add_npcs()
     sf::Vector2f bear_spawn{100.f, 200.f};
     //add_npc(Creature::Bunny, bunny_spawn);
     //add_npc(Creature::Bear, bear_spawn);
-
-    // sort enemy spawn points so they can be iter through in an expected way
-    std::sort(m_npc_spawn_points.begin(), m_npc_spawn_points.end(), []
-            (SpawnPoint lhs, SpawnPoint rhs) {
-        // sorting algorithm used - descending sort, based on y-axis
-        return (lhs.vec2.y < rhs.vec2.y);
-    });
 }
 
 /**
@@ -317,11 +574,167 @@ void World::destroy_entities_outside_chunk()
                 e.destroy();
     });
     /// Push destroy() command into command queue.
-    m_command_queue.push(command);
+    m_command_queue.push(std::move(command));
     */
 }
 
 
+/**
+ * Subscribes the world's reactions to gameplay events, each called once per
+ * batch of events.
+ */
+void World::subscribe_events()
+{
+    m_events.subscribe<Events::Damage>(
+            [this] (std::span<const Events::Damage> events) {
+        on_damage(events);
+    });
+    m_events.subscribe<Events::PickupCollected>(
+            [this] (std::span<const Events::PickupCollected> events) {
+        on_pickup_collected(events);
+    });
+    m_events.subscribe<Events::CreatureDied>(
+            [this] (std::span<const Events::CreatureDied> events) {
+        on_creature_died(events);
+    });
+}
+
+/**
+ * Damages the targets of a batch of damage events.
+ * @note Targets reclaimed since the event was published are skipped.
+ */
+void World::on_damage(std::span<const Events::Damage> events)
+{
+    for (const Events::Damage& event : events) {
+        if (Entity* target = m_entity_registry.get(event.target))
+            target->damage(event.amount);
+    }
+}
+
+/**
+ * Buffers the effects of collected pickups on their collectors, then resolves
+ * them in one pass.
+ */
+void World::on_pickup_collected(std::span<const Events::PickupCollected> events)
+{
+    for (const Events::PickupCollected& event : events) {
+        if (Creature* collector = node_cast<Creature>(
+                    m_entity_registry.get(event.collector)))
+            m_effects.push(*collector, event.effect);
+    }
+    m_effects.apply();
+}
+
+/**
+ * Scores killed enemies, and drops pickups where they died.
+ * @attention Enemy(ies) have 1/3 chance to drop Pickup.
+ * @see random_int() for RNG implementation.
+ */
+void World::on_creature_died(std::span<const Events::CreatureDied> events)
+{
+    for (const Events::CreatureDied& event : events) {
+        if (!(event.category & Category::EnemyNpc))
+            continue;
+        ++m_score;
+        if (random_int(3) == 0)
+            drop_pickup(event.position);
+    }
+}
+
+/**
+ * Spawns a random pickup at position.
+ */
+void World::drop_pickup(sf::Vector2f position)
+{
+    /// Get random pickup type, using random_int() and type count of pickups.
+    auto type = static_cast<Pickup::Type>(random_int(Pickup::TypeCount));
+
+    std::unique_ptr<Pickup> pickup(new Pickup(type, m_textures));
+    pickup->set_context(&m_entity_context);
+    pickup->setPosition(position);
+    pickup->set_velocity(0.f, 1.f);
+
+    /// Spawn pickup, attached once to the foreground layer with the entities
+    /// spawned this tick.
+    m_spawns.push(std::move(pickup));
+}
+
+/**
+ * @return Returns the count of enemies killed.
+ */
+std::size_t World::get_score() const
+{
+    return m_score;
+}
+
+/**
+ * Delivers a command addressed to an entity directly, without traversing the
+ * scene graph, or broadcasts it to its category otherwise.
+ * @note Commands addressed to a reclaimed entity are dropped.
+ */
+void World::dispatch_command(const Command& command, sf::Time delta_time)
+{
+    if (command.target.is_valid()) {
+        if (Entity* entity = m_entity_registry.get(command.target))
+            command.action(*entity, delta_time);
+    } else {
+        m_scene_graph.on_command(command, delta_time);
+    }
+}
+
+/**
+ * Moves commands pushed from other threads into m_command_queue, and reports
+ * pushes that failed because the remote queue was full.
+ */
+void World::drain_remote_commands()
+{
+    ConcurrentCommandQueue::Stats stats = m_remote_commands.get_stats();
+    if (stats.rejected_since_drain > 0)
+        std::cerr << "Remote command queue full, rejected "
+            << stats.rejected_since_drain << " command(s) (total "
+            << stats.rejected << " of " << stats.pushed + stats.rejected
+            << ", capacity " << stats.capacity << ")\n";
+    m_remote_commands.drain_into(m_command_queue);
+}
+
+/**
+ * Guided projectiles acquire the nearest enemy within their guide range.
+ * @note Enemies are indexed in m_enemy_index first (by the first command), so
+ * each retargeting projectile queries only nearby cells instead of every
+ * enemy. Projectiles only query when their retarget countdown is over.
+ */
+void World::guide_projectiles()
+{
+    m_enemy_index.clear();
+
+    /// Index all live enemies.
+    Command enemy_collector;
+    enemy_collector.category = Category::EnemyNpc;
+    enemy_collector.action = derived_action<Creature>(
+            [this] (Creature& enemy, sf::Time) {
+        if (!enemy.is_destroyed())
+            m_enemy_index.insert(&enemy, enemy.get_world_position());
+    });
+
+    /// Guide projectiles torwards the nearest indexed enemy.
+    Command projectile_guider;
+    projectile_guider.category = Category::PlayerProjectile;
+    projectile_guider.action = derived_action<Projectile>(
+            [this] (Projectile& projectile, sf::Time) {
+        if (!projectile.is_retargeting())
+            return;
+        projectile.reset_retarget_countdown();
+        SceneNode* target = m_enemy_index.query_nearest(
+                projectile.get_world_position(), projectile.get_guide_range());
+        if (target != nullptr)
+            projectile.guide_torwards(target->get_world_position());
+    });
+
+    /// Push commands into command queue, collector first.
+    m_command_queue.push(std::move(enemy_collector));
+    m_command_queue.push(std::move(projectile_guider));
+}
+
 /** Helper function that determines if the colliding scene nodes match certain
  * expected categories.
  * @return Returns true if the colliders match the expected categories, false
@@ -360,44 +773,56 @@ sf::FloatRect World::get_view_bounds() const
 }
 
 /**
- * @return Returns a sf::FloatRect that is the bounds of the current world chunk.
+ * @return Returns a sf::FloatRect that is the bounds of the current world chunk,
+ * the area in which chunks are active.
  * @note Chunks are a pixel offset from current view bounds (x, y).
  */
 sf::FloatRect World::get_chunk_bounds() const
 {
     /// Based on current view bounds.
     sf::FloatRect bounds = get_view_bounds();
-    /// Chunks are 1000 pixel offset from current view bounds (x, y).
-    bounds.top -+ 1000.f;
-    bounds.height += 1000.f;
+    /// Chunks are ACTIVATION_RADIUS pixel offset from current view bounds, on
+    /// every side.
+    bounds.left -= ACTIVATION_RADIUS;
+    bounds.top -= ACTIVATION_RADIUS;
+    bounds.width += 2.f * ACTIVATION_RADIUS;
+    bounds.height += 2.f * ACTIVATION_RADIUS;
     return bounds;
 }
 
 /** Uses matches_categories() to decide how to handle each collider pair as
  * desired.
+ * @note Reactions (damage, pickup effects) are published as events, resolved
+ * in batches right after collisions.
  */
 void World::handle_collisions()
 {
     /// Initialize collision_pairs set for scene graph to use.
     std::set<SceneNode::Pair> collision_pairs;
     m_scene_graph.check_scene_collision(m_scene_graph, collision_pairs);
+    m_debug_contacts.clear();
     for (SceneNode::Pair pair : collision_pairs) {
-        /// For Player/Pickup, apply the pickup to the player and destroy the
-        /// pickup.
+        if (m_debug_draw.is_enabled())
+            m_debug_contacts.emplace_back(pair.first->get_world_position(),
+                    pair.second->get_world_position());
+        /// For Player/Pickup, buffer the pickup's effect on the player and
+        /// destroy the pickup.
         if (matches_categories(pair, Category::Player, Category::PlayerPickup)) {
-            // static cast the pair's type to the expected type to make sure
-            // (safe because the pair's type is expected to match), and create
+            // downcast the pair's nodes to the expected types (checked by type
+            // tag, the pair's categories are expected to match), and create
             // local variables storing each - to work with.
-            auto& player = static_cast<Creature&>(*pair.first);
-            auto& pickup = static_cast<Pickup&>(*pair.second);
-            pickup.apply(player);
+            auto& player = node_cast<Creature>(*pair.first);
+            auto& pickup = node_cast<Pickup>(*pair.second);
+            m_events.publish(Events::PickupCollected{player.get_handle(),
+                    pickup.get_effect()});
             pickup.destroy();
         } else if (matches_categories(pair, Category::Player,
                     Category::EnemyNpc)) {
             /// For Player/EnemyNpc, damage the player and destroy the enemy.
-            auto& player = static_cast<Creature&>(*pair.first);
-            auto& enemy = static_cast<Creature&>(*pair.second);
-            player.damage(enemy.get_hitpoints());
+            auto& player = node_cast<Creature>(*pair.first);
+            auto& enemy = node_cast<Creature>(*pair.second);
+            m_events.publish(Events::Damage{player.get_handle(),
+                    enemy.get_hitpoints()});
             enemy.destroy();
         } else if (matches_categories(pair, Category::Player,
                     Category::EnemyProjectile)
@@ -407,9 +832,10 @@ void World::handle_collisions()
             /// (handled the same because projectiles are to be handled the same,
             /// regardless of recipient), damage the recipient and destroy the
             /// projectile.
-            auto& creature = static_cast<Creature&>(*pair.first);
-            auto& projectile = static_cast<Projectile&>(*pair.second);
-            creature.damage(projectile.get_damage());
+            auto& creature = node_cast<Creature>(*pair.first);
+            auto& projectile = node_cast<Projectile>(*pair.second);
+            m_events.publish(Events::Damage{creature.get_handle(),
+                    projectile.get_damage()});
             projectile.destroy();
         }
     }
@@ -0,0 +1,54 @@
+#!/usr/bin/env bash
+#
+# Renders the same headless run twice and checks that every frame hash is
+# equal, e.g. before trusting --render hashes as an image regression check.
+#
+# usage: tools/check-render-hashes.sh <untitled-game> [options...]
+# e.g.   tools/check-render-hashes.sh ./untitled-game --horde --seed=1
+#
+# Runs under xvfb-run -a if DISPLAY is not set. Run from the directory the
+# game finds its fonts/ and res/ in. Exits with 1 if the runs differ.
+
+if [ $# -lt 2 ]; then
+    echo "usage: $0 <untitled-game> [options...]" >&2
+    exit 2
+fi
+game=$1
+shift
+
+run=()
+if [ -z "$DISPLAY" ]; then
+    if ! command -v xvfb-run > /dev/null; then
+        echo "$0: DISPLAY is not set and xvfb-run is not installed" >&2
+        exit 2
+    fi
+    run=(xvfb-run -a)
+fi
+
+dir=$(mktemp -d)
+trap 'rm -rf "$dir"' EXIT
+
+for i in 1 2; do
+    if ! "${run[@]}" "$game" "$@" --render="$dir/$i.tsv" 2> "$dir/$i.log"; then
+        cat "$dir/$i.log" >&2
+        exit 2
+    fi
+    # the summary line ends with the combined hash of all frames
+    hash=$(grep -o 'hash [0-9a-f]*$' "$dir/$i.log" | cut -d' ' -f2)
+    if [ -z "$hash" ]; then
+        cat "$dir/$i.log" >&2
+        echo "$0: run $i printed no render summary" >&2
+        exit 2
+    fi
+    frames=$(($(wc -l < "$dir/$i.tsv") - 1))
+    echo "run $i: $frames frames, combined hash $hash"
+    # frame, tick and hash columns, times differ between runs
+    cut -f1,2,5 "$dir/$i.tsv" > "$dir/$i.hashes"
+done
+
+if ! diff -q "$dir/1.hashes" "$dir/2.hashes" > /dev/null; then
+    echo "frame hashes differ, first differences (frame, tick, hash):"
+    diff "$dir/1.hashes" "$dir/2.hashes" | head -n 20
+    exit 1
+fi
+echo "frame hashes equal"